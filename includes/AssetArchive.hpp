@@ -0,0 +1,37 @@
+#ifndef ASSET_ARCHIVE_HPP
+#define ASSET_ARCHIVE_HPP
+
+#include <raylib.h>
+#include <string>
+#include <vector>
+
+// Every image the game draws, decoded ahead of time into one file. Images
+// with identical pixels are stored once and every path that had them points
+// at the same copy. Pixels are kept either raw (RGBA8, uploaded straight
+// from the mapped file) or as a QOI stream, which is several times smaller
+// and still decodes much faster than PNG.
+//
+// The archive is produced offline by Build (run the game with --pack-assets,
+// or `make pack`) and has to be rebuilt when the art changes. When it is
+// missing every lookup falls back to the loose files.
+class AssetArchive
+{
+public:
+  static bool Open(const std::string &archivePath);
+  static void Close();
+  static bool IsOpen();
+
+  // The path a file's texture is cached under: the first path in the
+  // archive holding the same pixels, or path itself
+  static std::string Resolve(const std::string &path);
+
+  // Pixels of path, RGBA8. Raw images point into the archive and set
+  // borrowed, they must not be unloaded; decoded ones belong to the caller.
+  // No data when path isn't packed. Safe to call from worker threads
+  static Image GetImage(const std::string &path, bool *borrowed = nullptr);
+  static bool GetSize(const std::string &path, int *width, int *height); // From the table of contents
+
+  static bool Build(const std::vector<std::string> &sourceDirs, const std::string &archivePath, bool compress);
+};
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef ASSET_LOADER_HPP
+#define ASSET_LOADER_HPP
+
+#include <raylib.h>
+#include "JobSystem.hpp"
+#include "TextureCache.hpp"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Loads textures and sounds in the background. Files are read and decoded
+// (PNG to pixels, MP3 to samples) by jobs on the worker threads, images in
+// the AssetArchive are decoded from there or just paged in; Update then
+// uploads images to the GPU on the main thread as their jobs finish,
+// skipping ones still decoding so a slow file doesn't hold up the rest
+// (earliest queued first among the ready ones), until its per-frame
+// budget is spent. Textures queued at a scale are
+// resampled on the workers too. Uploaded textures go into the
+// TextureCache and the loader holds a reference until Release, so whoever
+// acquires them afterwards gets a cache hit.
+//
+// Without worker threads the decoding happens in Update too, within the
+// same budget.
+class AssetLoader
+{
+public:
+  explicit AssetLoader(JobSystem &jobSystem);
+  ~AssetLoader();
+  AssetLoader(const AssetLoader &) = delete;
+  AssetLoader &operator=(const AssetLoader &) = delete;
+
+  // Queuing a path twice is a no-op. Scaled textures are acquired from the
+  // TextureCache with the same scale
+  void QueueTexture(const std::string &path, float scale = 1.0f);
+  void QueueSound(const std::string &path);
+
+  // Main thread, once per frame. Always finishes at least one asset when
+  // one is ready, so a small budget still makes progress
+  void Update(float budgetMs);
+  void Finish(); // Blocks until everything queued is ready
+
+  bool IsReady(const std::string &path, float scale = 1.0f) const;
+  bool IsDone() const { return readyCount == (int)assets.size(); }
+  float GetProgress() const { return assets.empty() ? 1.0f : (float)readyCount / (float)assets.size(); }
+
+  // A new Sound from the decoded samples, or loaded from disk when the path
+  // was never queued. The caller unloads it as usual
+  Sound CreateSound(const std::string &path) const;
+
+  // Drops the loader's texture references and decoded sounds and empties
+  // the queue, call once the scene holds its own handles. Waits for decodes
+  // still running
+  void Release();
+
+private:
+  enum class AssetKind
+  {
+    TEXTURE,
+    SOUND
+  };
+
+  struct Asset
+  {
+    std::string path;
+    AssetKind kind;
+    Image image;
+    bool borrowed; // Image points into the AssetArchive
+    float scale;   // Load scale, see TextureCache::GetLoadScale
+    Wave wave;
+    std::atomic<bool> decoded;
+    bool ready;
+  };
+
+  void Queue(const std::string &path, AssetKind kind, float scale);
+  static std::string GetKey(const std::string &path, float scale);
+  static void Decode(Asset &asset);
+  void Upload(Asset &asset);
+
+  JobSystem &jobs;
+  JobCounter pending;
+  bool threaded;
+  std::vector<std::unique_ptr<Asset>> assets; // Queue order
+  std::unordered_map<std::string, Asset *> byPath; // Path, and scale when not 1
+  std::vector<TextureHandle> textures;
+  size_t firstWaiting; // Assets before this are all ready
+  int readyCount;
+};
+
+#endif
@@ -0,0 +1,223 @@
+#ifndef BOT_POOL_HPP
+#define BOT_POOL_HPP
+
+#include <raylib.h>
+#include "GameType.hpp"
+#include "SpriteAtlas.hpp"
+#include "RenderQueue.hpp"
+#include "SpatialGrid.hpp"
+#include "JobSystem.hpp"
+#include "FlowField.hpp"
+#include "Rng.hpp"
+#include <cstdint>
+#include <vector>
+
+const int BotTypeCount = 4;
+
+// Animation clips a bot can play, also indexes the sprite sheets
+enum class BotClip : unsigned char
+{
+  IDLE_RIGHT,
+  IDLE_LEFT,
+  WALK,
+  RUN,
+  ATTACK
+};
+
+const int BotClipCount = 5;
+
+// Sprite sheets shared by every bot of one type, one per clip
+struct BotSprites
+{
+  SpriteRegion clips[BotClipCount];
+};
+
+// Everything bots of one type have in common. Read-only while ticking
+struct BotArchetype
+{
+  float speed; // Pixels per second
+  int maxHealth;
+  float attackRange;
+  float chaseRange;
+  float fleeingRange;
+  float attackCooldown;
+  float wanderTime; // Seconds idle before the first wander
+  float spawnDelay;
+  float width, height;
+  Animation clips[BotClipCount];
+};
+
+const int BotLodLevels = 4;
+
+// How often bots think depending on where they are. Level 0 is nearest
+struct BotLodSettings
+{
+  float distances[BotLodLevels - 1]; // Distance to the player where each level ends
+  int intervals[BotLodLevels];       // Ticks between decisions per level
+  float budgetMs;                    // Think pass time to stay under, 0 turns adapting off
+  Rectangle view;                    // Bots inside think one level more often
+};
+
+// Counters of the last think pass
+struct BotLodStats
+{
+  int thinking; // Bots that ran their decision logic
+  int coasting; // Bots that moved on their last decision
+  int perLevel[BotLodLevels];
+  int bias; // Levels added to every bot because of the budget
+  float thinkMs;
+};
+
+// All bots of the world in structure-of-arrays form. Fields the tick touches
+// every frame sit in their own contiguous arrays so each pass only streams
+// through the data it needs; per-type stats and sprites live in archetypes.
+// A bot is its index, which is also its id in the spatial grid.
+class BotPool
+{
+public:
+  BotPool();
+  BotPool(const BotPool &) = delete;
+  BotPool &operator=(const BotPool &) = delete;
+
+  // Shared sprites for all bot types, only needed when drawing
+  static void LoadSprites();
+  static void UnloadSprites();
+  static std::vector<std::string> GetSheetPaths(); // Everything LoadSprites acquires
+
+  void Clear();
+  void Reserve(int count);
+  int Spawn(BotType type, float x, float y);
+  void SetWorldSize(Vector2 size);
+  void SetSeed(uint64_t poolSeed) { seed = poolSeed; } // For bots spawned after the call
+  void SetFlowField(const FlowField *field) { flowField = field; } // Steers chasing bots, may be null
+
+  // Tick passes, run in this order
+  void Integrate(float deltaTime);                 // Spawn and attack timers, bounds
+  void Animate(float deltaTime);                   // Animation clips, attack end
+  void Think(Vector2 playerPos, float deltaTime, JobSystem *jobs = nullptr); // AI decisions and steering
+  void Draw(RenderQueue &queue, float alpha = 1.0f) const;
+
+  // Combat
+  void TakeDamage(int bot, int damage);
+  bool CanAttack(int bot) const;
+
+  // Per bot getters
+  int GetCount() const { return (int)posX.size(); }
+  int GetAliveCount() const;
+  Vector2 GetPosition(int bot) const { return {posX[bot], posY[bot]}; }
+  Rectangle GetBounds(int bot) const;
+  Rectangle GetCollisionBounds(int bot, Vector2 position) const; // Bounds used for bot to bot avoidance
+  BotType GetType(int bot) const { return types[bot]; }
+  BotState GetState(int bot) const { return states[bot]; }
+  Direction GetDirection(int bot) const { return directions[bot]; }
+  int GetHealth(int bot) const { return health[bot]; }
+  int GetMaxHealth(int bot) const { return archetypes[(int)types[bot]].maxHealth; }
+  bool IsAlive(int bot) const { return health[bot] > 0; }
+  bool IsSpawned(int bot) const { return (flags[bot] & SPAWNED) != 0; }
+  void SetSpawned(int bot, bool spawned);
+  const SpatialGrid &GetGrid() const { return grid; }
+
+  // Calls visit(bot) for every living bot whose full bounds overlap area,
+  // using the grid as broadphase. Returns how many candidates it looked at
+  template <typename Visitor>
+  int QueryBounds(Rectangle area, Visitor &&visit) const;
+
+  // Avoidance bounds are this fraction of the sprite, from its top left
+  static constexpr float CollisionScale = 0.8f;
+
+  // Take GetBounds from the opaque part of each type's frames instead of
+  // the whole frame. Before LoadSprites; headless runs load no sprites and
+  // keep whole frames, so only runs with the same setting replay alike
+  static void SetTrimmedBounds(bool enabled) { trimmedBounds = enabled; }
+  static float GetMaxSize();
+
+  static const BotArchetype &GetArchetype(BotType type) { return archetypes[(int)type]; }
+
+  // AI level of detail. The budget reacts to wall clock time, so leave it at
+  // 0 where runs must be reproducible
+  void SetLodSettings(const BotLodSettings &settings) { lodSettings = settings; }
+  const BotLodSettings &GetLodSettings() const { return lodSettings; }
+  const BotLodStats &GetLodStats() const { return lodStats; }
+
+private:
+  enum Flags : uint8_t
+  {
+    SPAWNED = 1,
+    ATTACKING = 2,
+    THOUGHT = 4 // Ran its decision logic this tick
+  };
+
+  static BotArchetype archetypes[BotTypeCount];
+  static BotSprites sprites[BotTypeCount];
+  static Rectangle hitBounds[BotTypeCount]; // GetBounds as a fraction of the frame
+  static bool trimmedBounds;
+
+  // Hot simulation state
+  std::vector<float> posX, posY;
+  std::vector<float> prevX, prevY; // Position at the start of the tick, for interpolation
+  std::vector<float> nextX, nextY; // Positions written by Think, swapped in after it
+  std::vector<float> velocityX, velocityY; // Movement of the last decision, for ticks without one
+  std::vector<float> thinkElapsed;         // Seconds since the last decision
+  std::vector<float> stateTimer;
+  std::vector<float> attackTimer;
+  std::vector<float> spawnTimer;
+  std::vector<float> wanderTimer;
+  std::vector<float> wanderTime;
+  std::vector<float> targetX, targetY; // Wander target
+  std::vector<int> health;
+  std::vector<BotType> types;
+  std::vector<BotState> states;
+  std::vector<Direction> directions;
+  std::vector<uint8_t> flags;
+  std::vector<Rng> rng;
+  std::vector<uint8_t> lodLevels;
+
+  // Animation state, only read by Animate and Draw
+  std::vector<BotClip> clips;
+  std::vector<Animation> anims;
+
+  SpatialGrid grid; // Active bots by collision bounds
+  Vector2 worldSize;
+  const FlowField *flowField;
+  uint64_t seed;
+
+  BotLodSettings lodSettings;
+  BotLodStats lodStats;
+  int lodBias;
+  long long thinkTick;
+
+  int LodLevel(int bot, Vector2 playerPos) const;
+  void ScheduleBot(int bot, Vector2 playerPos, float deltaTime);
+  void ThinkBot(int bot, Vector2 playerPos, float deltaTime, float elapsed);
+  int Random(int bot, int min, int max);
+  void SetState(int bot, BotState newState);
+  void SetClip(int bot, BotClip clip);
+  void Attack(int bot);
+  void ChasePlayer(int bot, Vector2 playerPos, float deltaTime);
+  void Wander(int bot, float deltaTime, float elapsed);
+  void MoveAway(int bot, Vector2 threat, float deltaTime);
+  void FaceTowards(int bot, float directionX, float threshold);
+  bool WouldCollideWithBots(int bot, Vector2 position) const;
+  Vector2 GetAvoidanceDirection(int bot, Vector2 blockedPosition);
+  void SyncGrid(int bot);
+};
+
+template <typename Visitor>
+int BotPool::QueryBounds(Rectangle area, Visitor &&visit) const
+{
+  // The grid holds the smaller avoidance bounds, grow the query so every bot
+  // whose full bounds reach the area is still found
+  float margin = GetMaxSize() * (1.0f - CollisionScale);
+  Rectangle query = {area.x - margin, area.y - margin, area.width + margin * 2.0f, area.height + margin * 2.0f};
+  int candidates = 0;
+
+  grid.QueryRect(query, [&](int bot, Rectangle)
+                 {
+                   candidates++;
+                   if (CheckCollisionRecs(area, GetBounds(bot)))
+                     visit(bot); });
+
+  return candidates;
+}
+
+#endif
@@ -2,30 +2,37 @@
 #define BUTTON_H
 
 #include "raylib.h"
+#include "TextureCache.hpp"
+#include "Input.hpp"
 
 class Button
 {
 private:
-  Texture2D normalTexture;
-  Texture2D hoverTexture;
-  Texture2D clickTexture;
+  TextureHandle normalTexture;
+  TextureHandle hoverTexture;
+  TextureHandle clickTexture;
   Vector2 position;
+  Vector2 size; // Unscaled, from the image header so it's right while the texture streams in
   float scale;
   bool isPressed;
   bool hasHoverTexture;
   bool hasClickTexture;
 
+  Rectangle GetBounds() const;
+
 public:
   // Constructor for centered button with all effects (your current use case)
   Button(const char *normalFile, const char *hoverFile, const char *clickFile,
          float scale, bool centered = true, float yOffset = 0.0f);
 
-  ~Button();
-
   void Draw();
   void Update();
   bool IsClicked();
   bool IsHovered();
+
+  // Same as above for input latched by the simulation tick
+  void Update(const InputState &input);
+  bool IsClicked(const InputState &input);
   void SetPosition(Vector2 newposition);
 
   static Vector2 GetCenteredPosition(const char *file, float scale);
@@ -3,24 +3,39 @@
 
 #include <raylib.h>
 #include "GameType.hpp"
-#include "includes/GunFire.hpp"
+#include "SpriteAtlas.hpp"
+#include "RenderQueue.hpp"
+#include "Input.hpp"
+#include "ProjectilePool.hpp"
+#include "SoundPool.hpp"
 #include <string>
+#include <vector>
+
+class AssetLoader;
 
 class Character
 {
 private:
   // Textures
-  Texture2D idleTexture;
-  Texture2D idleLeftTexture;
-  Texture2D walkTexture;
-  Texture2D jumpTexture;
-  Texture2D shotTexture;
-  Texture2D runTexture;
-  Texture2D MeleeTexture;
-  Texture2D bulletTexture;
-  Sound MeleeSound;
-  Sound gunshotSound;
-  bool soundLoaded;
+  SpriteRegion idleTexture;
+  SpriteRegion idleLeftTexture;
+  SpriteRegion walkTexture;
+  SpriteRegion jumpTexture;
+  SpriteRegion shotTexture;
+  SpriteRegion runTexture;
+  SpriteRegion MeleeTexture;
+  SoundPool *sounds; // Where the effects play, owned by the controller
+  int gunshotEffect;
+  int meleeEffect;
+
+  // Resource paths, loaded by LoadResources so the simulation can run
+  // without a window or audio device
+  std::string idlePath, idleLeftPath, walkPath, runPath, shotPath, jumpPath, attackPath;
+  std::string gunshotSoundPath, attackSoundPath;
+
+  // Sounds requested by the simulation, played by PlayPendingSounds
+  int pendingGunshots;
+  int pendingMelee;
 
   // Animations
   Animation idleRightAnim;
@@ -34,7 +49,9 @@ private:
   // Properties
   float x, y;
   float width, height;
-  float speed;
+  float speed;     // Pixels per second
+  float velocityX; // Horizontal velocity requested by input this tick
+  float prevX, prevY; // Position at the start of the tick, for interpolation
   Direction direction;
   bool isWalking;
   bool isRunning;
@@ -42,10 +59,10 @@ private:
   // Jump Properties
   bool isJumping;
   bool isOnGround;
-  float jumpVelocity;
-  float gravity;
+  float jumpVelocity; // Pixels per second
+  float gravity;      // Pixels per second squared
   float groundY;
-  float jumpSpeed;
+  float jumpSpeed; // Pixels per second
   // Shot properties
   float fireTimer;
   float fireCooldown;
@@ -58,12 +75,13 @@ private:
   int AttackDamage;
   bool HitRegistered;
   float currentMovementSpeed = 0.0f;
+  Vector2 worldSize; // Area the character is kept inside
   Vector2 position;
   int direct;
-  std::vector<Gunfire> bullets;
+  ProjectilePool *projectiles; // Where shots go, owned by the world
   // Draw method
   CharacterState GetCurrentState() const;
-  void GetTextureAndAnimation(Texture2D &texture, Rectangle &source);
+  void GetTextureAndAnimation(const SpriteRegion *&sheet, Rectangle &source);
 
 public:
   Character(const std::string &idlePath,
@@ -75,23 +93,29 @@ public:
             const std::string &attack,
             const std::string &gunshotSoundPath,
             const std::string &attackSoundPath,
-            const std::string &bulletPath,
             float startX,
             float startY,
-            float characterSpeed = 2.0f);
+            float characterSpeed = 120.0f);
 
   // Destructor
   ~Character();
 
+  // Load textures and sounds, only needed when rendering. Sounds come from
+  // the loader's decoded samples when given one
+  void LoadResources(const AssetLoader *loader = nullptr);
+  std::vector<std::string> GetSheetPaths() const;
+  std::vector<std::string> GetSoundPaths() const;
+  void PlayPendingSounds();
+
   // Update methods
-  void Update();
-  void HandleInput();
+  void Update(float deltaTime);
+  void HandleInput(const InputState &input);
   void UpdatePosition(float deltaX);
-  void UpdateAnimations();
-  void UpdateJumpAnimation();
-  void UpdateShotAnimation();
-  void UpdateRunAnimation();
-  void UpdateAttackAnimation();
+  void UpdateAnimations(float deltaTime);
+  void UpdateJumpAnimation(float deltaTime);
+  void UpdateShotAnimation(float deltaTime);
+  void UpdateRunAnimation(float deltaTime);
+  void UpdateAttackAnimation(float deltaTime);
   // Movement methods
   void MoveLeft();
   void MoveRight();
@@ -113,7 +137,7 @@ public:
   bool CanAttack() const;
   void ResetAttack();
 
-  void Draw();
+  void Draw(RenderQueue &queue, float alpha = 1.0f);
 
   float GetX() const { return x; }
   float GetY() const { return y; }
@@ -141,6 +165,9 @@ public:
   void SetAttackRange(float newRange) { AttackRange = newRange; }
   void SetAttackDamage(int newDamage) { AttackDamage = newDamage; }
   void SetSize(float newWidth, float newHeight);
+  void SetWorldSize(Vector2 size) { worldSize = size; }
+  void SetProjectilePool(ProjectilePool *pool) { projectiles = pool; }
+  void SetSoundPool(SoundPool *pool) { sounds = pool; } // Before LoadResources
   Vector2 GetPosition() const { return position; }
 
   Character(const Character &) = delete;
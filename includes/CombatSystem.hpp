@@ -0,0 +1,43 @@
+#ifndef COMBAT_SYSTEM_HPP
+#define COMBAT_SYSTEM_HPP
+
+#include <raylib.h>
+#include "BotPool.hpp"
+#include "ProjectilePool.hpp"
+#include <vector>
+
+// Counters of the last Resolve
+struct CombatStats
+{
+  int projectiles;     // Projectiles tested
+  int bots;            // Living bots they could have hit
+  int broadphasePairs; // Projectile/bot pairs returned by the grid
+  int narrowTests;     // Swept tests actually run
+  int hits;
+};
+
+struct DamageEvent
+{
+  int bot;
+  int damage;
+};
+
+// Projectile against bot hits. Each projectile's movement this tick is a
+// segment; the grid finds the bots near it and a swept test against their
+// bounds picks the first one along the path, so fast projectiles can't skip
+// over a bot between ticks. Damage is collected and applied in one batch
+// after all projectiles are resolved.
+class CombatSystem
+{
+public:
+  void Resolve(ProjectilePool &projectiles, BotPool &bots);
+
+  const CombatStats &GetStats() const { return stats; }
+  const std::vector<DamageEvent> &GetDamageEvents() const { return damageEvents; }
+
+private:
+  std::vector<DamageEvent> damageEvents;
+  CombatStats stats = {};
+};
+
+#endif
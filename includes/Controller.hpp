@@ -5,8 +5,20 @@
 #include "includes/GameLayer.hpp"
 #include "includes/GameType.hpp"
 #include "includes/Character.hpp"
-#include "includes/Bot.hpp"
+#include "includes/BotPool.hpp"
+#include "includes/World.hpp"
 #include "includes/Popup.hpp"
+#include "includes/TextureCache.hpp"
+#include "includes/SpriteAtlas.hpp"
+#include "includes/RenderQueue.hpp"
+#include "includes/LayerStrip.hpp"
+#include "includes/Input.hpp"
+#include "includes/JobSystem.hpp"
+#include "includes/InputLog.hpp"
+#include "includes/AssetLoader.hpp"
+#include "includes/AssetArchive.hpp"
+#include "includes/SoundPool.hpp"
+#include "includes/MusicPlayer.hpp"
 #include <vector>
 #include <string>
 
@@ -17,46 +29,87 @@ public:
   Controller(const Controller &) = delete;
   Controller &operator=(const Controller &) = delete;
   void Init(int screenW, int screenH, int originalW, int originalH);
-  void Update();
-  void Draw();
+
+  // Both before Init. Recording writes every tick's input to path on
+  // Unload; a replay takes the seed and every tick's input from the log
+  void SetRecording(const std::string &path) { recordPath = path; }
+  void SetReplay(const InputLog *log) { replay = log; }
+  bool IsReplayFinished() const { return replay != nullptr && replayTick >= replay->GetTickCount(); }
+
+  void PollInput();
+  void Update(float deltaTime);
+  void Draw(float alpha);
   void Unload();
 
+  // Fixed simulation step, Update is always called with this
+  static constexpr float FixedStep = 1.0f / 60.0f;
+
 private:
   Gamestate currentState;
   // core
-  Character *player;
-  std::vector<Bot> bots;
-  void SpawnBots(int count);
+  JobSystem jobs;
+  AssetLoader loader; // Gameplay assets, streamed in while the menu runs
+  SoundPool sounds;   // Gameplay effects
+  bool gameplayLoaded;
+  World world;
+  RenderQueue renderQueue;
   // UI
   Button *startButton, *exitButton, *yesButton, *noButton;
   Popup popup;
 
   Sound clickSound;
-  Music backgroundMusic;
-  Music playingMusic;
+  MusicPlayer music; // Streams on its own thread
+  int menuTrack, playingTrack;
   // Title
-  Texture2D titleTexture;
+  TextureHandle titleTexture;
   Vector2 titlePosition;
   float titleScale;
   // Layers
   std::vector<Layer *> menuLayers;
   std::vector<Layer *> gameLayers;
   std::vector<Gamelayer *> mainlayers;
+  // Baked composites of the layers above, one per shared parallax factor
+  std::vector<LayerStrip *> menuStrips;
+  std::vector<LayerStrip *> gameStrips;
+  std::vector<LayerStrip *> mainStrips;
 
   std::string animatedText;
-  int frameCounter, dotCount, gameTimer;
+  int dotCount;
+  float dotTimer, gameTimer; // Seconds
   bool fadeOutComplete, showExitPop, playingMusicStarted, running;
   int screenWidth, screenHeight;
   int originalWidth, originalHeight;
   float scaleX, scaleY;
   float scale;
   int maxDots;
-  int fadeDuration;
-
-  void UpdateMenu();
-  void UpdateGame();
-  void UpdatePlaying();
-  void DrawMenu();
-  void DrawGame();
-  void DrawPlaying();
+  float fadeDuration; // Seconds
+
+  // Input latched since the last simulation tick
+  InputState input;
+
+  // Session recording and playback
+  InputLog recording;
+  std::string recordPath;
+  const InputLog *replay;
+  int replayTick;
+
+  // Textures and sounds a state shows or plays
+  struct SceneManifest
+  {
+    std::vector<std::string> textures;
+    std::vector<std::string> backgrounds; // Loaded at the layer scale
+    std::vector<std::string> sounds;
+  };
+
+  SceneManifest GetManifest(Gamestate state) const;
+  void PrefetchScene(Gamestate state); // Queues its manifest on the loader
+  void EnterState(Gamestate state);    // Releases the scene being left
+  void ReleaseScene(Gamestate state);
+  void StreamAssets();
+  void UpdateMenu(float deltaTime);
+  void UpdateGame(float deltaTime);
+  void UpdatePlaying(float deltaTime);
+  void DrawMenu(float alpha);
+  void DrawGame(float alpha);
+  void DrawPlaying(float alpha);
 };
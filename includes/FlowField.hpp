@@ -0,0 +1,89 @@
+#ifndef FLOW_FIELD_HPP
+#define FLOW_FIELD_HPP
+
+#include <raylib.h>
+#include "JobSystem.hpp"
+#include <cstdint>
+#include <vector>
+
+// Shortest path directions toward one target over a grid of cells. Each cell
+// has a cost to enter (1 for open ground, Blocked for walls); the integration
+// pass spreads the total cost to reach the target out from the target's cell,
+// then every cell points at its cheapest neighbour. Cells with a clear
+// rectangle between them and the target are marked as in sight and steer
+// straight at the target instead. Any number of agents can then sample their
+// direction in O(1).
+//
+// The field is only rebuilt when the target moves to another cell or the
+// costs change, and never while every cell is open ground: every direction
+// would point straight at the target then, which is what agents do anyway
+// when Sample returns zero. With a range set, a build only covers the cells
+// within that distance of the target, so its cost no longer grows with the
+// world.
+class FlowField
+{
+public:
+  static constexpr uint8_t Blocked = 255;
+
+  explicit FlowField(float cellSize = 32.0f);
+
+  void SetBounds(Rectangle area); // Resets all costs to open ground
+  void SetCost(Rectangle area, uint8_t cost);
+  void ClearCosts();
+  void SetRange(float radius); // 0 builds over the whole area
+
+  // Rebuilds toward target when needed, returns whether it did
+  bool Update(Vector2 target, JobSystem *jobs = nullptr);
+
+  // Unit direction to follow from position. Zero at the target, in blocked or
+  // unreachable cells and before the first build
+  Vector2 Sample(Vector2 position) const;
+
+  bool IsBlocked(Vector2 position) const { return !costs.empty() && costs[CellIndex(position)] == Blocked; }
+  bool HasObstacles() const { return hasObstacles; } // Any cell costs more than open ground
+  float GetCellSize() const { return cellSize; }
+  int GetRebuildCount() const { return rebuildCount; }
+  float GetLastBuildMs() const { return lastBuildMs; }
+
+private:
+  static constexpr uint32_t Unreachable = UINT32_MAX;
+
+  int CellIndex(Vector2 position) const
+  {
+    int cx = (int)((position.x - origin.x) * inverseCellSize);
+    int cy = (int)((position.y - origin.y) * inverseCellSize);
+    cx = cx < 0 ? 0 : (cx >= columns ? columns - 1 : cx);
+    cy = cy < 0 ? 0 : (cy >= rows ? rows - 1 : cy);
+    return cy * columns + cx;
+  }
+
+  struct CellRect
+  {
+    int minX, minY, maxX, maxY; // Inclusive
+  };
+
+  void ResetWindow();
+  void Integrate();
+  void MarkSight();
+  void BuildDirections(int firstRow, int lastRow);
+
+  float cellSize;
+  float inverseCellSize;
+  Vector2 origin;
+  int columns, rows;
+  std::vector<uint8_t> costs;
+  std::vector<uint32_t> integration; // Total cost from each cell to the target
+  std::vector<Vector2> directions;
+  std::vector<uint8_t> inSight;
+  std::vector<std::vector<int>> buckets; // Open cells by cost, reused between builds
+  Vector2 target;
+  int targetCell;
+  int rangeCells;
+  CellRect window; // Cells the last build wrote to
+  bool hasObstacles;
+  bool dirty;
+  int rebuildCount;
+  float lastBuildMs;
+};
+
+#endif
@@ -2,21 +2,25 @@
 #define GAMELAYER_HPP
 
 #include <raylib.h>
+#include "TextureCache.hpp"
 
 class Gamelayer
 {
 private:
-  Texture2D texture;
+  TextureHandle texture;
   float yOffset;
   float scale;
-  float scrollX;
+  float parallax;
 
 public:
-  Gamelayer(const char *file, float y, float scal);
+  Gamelayer(const char *file, float y, float scal, float parallaxFactor = 0.5f);
   ~Gamelayer();
 
-  void UpdateLayer(float playerSpeed = 1.0f);
-  void Drawlayer();
+  const TextureHandle &GetTexture() const { return texture; }
+  float GetYOffset() const { return yOffset; }
+  float GetScale() const { return scale; }
+  float GetDrawScale() const { return scale / texture.GetScale(); } // Of the texture as loaded
+  float GetParallax() const { return parallax; }
 };
 
 #endif
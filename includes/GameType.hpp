@@ -2,7 +2,6 @@
 #define GAME_TYPES_HPP
 
 #include <raylib.h>
-#include <vector>
 
 enum class Gamestate
 {
@@ -11,6 +10,8 @@ enum class Gamestate
   PLAYING
 };
 
+const int GamestateCount = 3;
+
 enum class AnimationType
 {
   REPEATING,
@@ -62,13 +63,9 @@ struct Animation
   AnimationType type;
 };
 
-// Forward declarations
-class Layer;
-class Gamelayer;
-
 // Function declarations
-void Animation_Update(Animation *self);
+void Animation_Update(Animation *self, float deltaTime);
 Rectangle animation_frame(Animation *self, int frame_width, int frame_height);
-void UpdateAndDrawLayers(const std::vector<Layer *> &layers);
+Rectangle animation_frame(Animation *self, Rectangle sheet, int frame_width, int frame_height);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,47 @@
+#ifndef HEADLESS_HPP
+#define HEADLESS_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class InputLog;
+
+struct HeadlessConfig
+{
+  long long ticks = 36000; // Ten minutes of game time at 60 ticks per second
+  float worldWidth = 960.0f;
+  float worldHeight = 540.0f;
+  int botCount = 10;
+  uint64_t seed = 1;
+  int threads = 0; // 0 uses every core, 1 runs the bot AI on the main thread
+
+  // Play back a recorded session instead of the scripted input. The world
+  // size, bot count and seed come from the log, ticks from its length
+  const InputLog *replay = nullptr;
+  std::string timingsPath; // Per tick times as CSV when set
+};
+
+// Per tick wall clock times of a run, for comparing builds on one workload
+class TickTimings
+{
+public:
+  void Reserve(size_t count) { micros.reserve(count); }
+  void Add(long long tick, double us)
+  {
+    ticks.push_back(tick);
+    micros.push_back((float)us);
+  }
+  void Print(const char *label) const; // Average, percentiles and the worst tick
+  bool Save(const std::string &path) const;
+
+private:
+  std::vector<long long> ticks;
+  std::vector<float> micros;
+};
+
+// Steps the world as fast as possible without a window or audio device and
+// prints timing, for soak tests and AI/physics benchmarks on build machines
+int RunHeadless(const HeadlessConfig &config);
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef IMAGE_INDEX_HPP
+#define IMAGE_INDEX_HPP
+
+#include <string>
+
+struct ImageInfo
+{
+  int width;
+  int height;
+};
+
+// Image sizes without decoding or uploading anything: from the
+// AssetArchive's table of contents when it holds the file, otherwise from
+// the PNG header, which is the first 24 bytes of the file. Other formats
+// are decoded on the CPU once. Answers are cached, so layout code can ask
+// every frame, before the window is up or in the headless tools.
+class ImageIndex
+{
+public:
+  static ImageInfo Get(const std::string &path); // 0 x 0 when unreadable
+
+  // Sprite sheets hold square frames side by side
+  static int GetFrameCount(const std::string &path);
+
+  static void Clear();
+};
+
+#endif
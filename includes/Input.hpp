@@ -0,0 +1,35 @@
+#ifndef INPUT_HPP
+#define INPUT_HPP
+
+#include <raylib.h>
+
+// Keyboard and mouse state for one simulation tick. Held keys are plain
+// flags, button presses are edges that stay latched until a tick uses them.
+struct InputState
+{
+  // Held keys
+  bool left;
+  bool right;
+  bool run;
+  bool jump;
+  bool fire;
+  bool melee;
+
+  // Mouse
+  Vector2 mouse;
+  bool primaryPressed;
+  bool primaryReleased;
+  bool secondaryPressed;
+};
+
+// Snapshot of the keyboard and mouse for the current frame
+InputState ReadInput();
+
+// Merge a frame snapshot into the pending tick input. Held keys follow the
+// latest frame, edges accumulate so a short click is never lost between ticks
+void LatchInput(InputState &pending, const InputState &frame);
+
+// Drop the edges once a tick has seen them so the next tick doesn't repeat them
+void ClearInputEdges(InputState &pending);
+
+#endif
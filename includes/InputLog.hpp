@@ -0,0 +1,59 @@
+#ifndef INPUT_LOG_HPP
+#define INPUT_LOG_HPP
+
+#include "Input.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// What a replay needs to rebuild the recorded world
+struct InputLogHeader
+{
+  uint64_t seed;
+  float worldWidth, worldHeight;
+  int botCount;
+  uint32_t checksum; // World::GetChecksum after the last tick
+  bool hasChecksum;  // Older logs and unfinished sessions have none
+};
+
+// The input of every simulation tick of a session, plus the world seed, so
+// the session can be played back exactly, and the checksum it ended on so a
+// replay can tell when it didn't. Ticks are kept packed in memory
+// (6 bytes each) and runs of identical ticks are stored once on disk.
+class InputLog
+{
+public:
+  void Begin(const InputLogHeader &header);
+  void Record(const InputState &input, bool worldStep);
+  void SetChecksum(uint32_t checksum) // Once the session is over
+  {
+    header.checksum = checksum;
+    header.hasChecksum = true;
+  }
+
+  bool Save(const std::string &path) const;
+  bool Load(const std::string &path);
+
+  const InputLogHeader &GetHeader() const { return header; }
+  int GetTickCount() const { return (int)ticks.size(); }
+  InputState GetInput(int tick) const;
+  bool StepsWorld(int tick) const; // Whether the world stepped on this tick or it was spent in the menus
+
+private:
+  struct PackedTick
+  {
+    uint8_t keys;    // Held keys and mouse edges
+    uint8_t flags;   // Remaining edges, world step
+    int16_t mouseX, mouseY;
+
+    bool operator==(const PackedTick &other) const
+    {
+      return keys == other.keys && flags == other.flags && mouseX == other.mouseX && mouseY == other.mouseY;
+    }
+  };
+
+  InputLogHeader header = {};
+  std::vector<PackedTick> ticks;
+};
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef JOB_SYSTEM_HPP
+#define JOB_SYSTEM_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Counts the unfinished jobs of a group, Wait returns once it reaches zero
+using JobCounter = std::atomic<int>;
+
+// Thread pool with one job queue per thread. A thread works through its own
+// queue newest first and, when that runs dry, steals the oldest job from
+// another queue. Threads that are not part of the pool (the main thread)
+// use queue 0 and help out while they Wait.
+//
+// With a thread count of 1 there are no workers and every job runs inline
+// in Run, which is the single threaded fallback.
+class JobSystem
+{
+public:
+  using Job = std::function<void()>;
+
+  // 0 picks one thread per hardware core, the calling thread included
+  explicit JobSystem(int threadCount = 0);
+  ~JobSystem();
+  JobSystem(const JobSystem &) = delete;
+  JobSystem &operator=(const JobSystem &) = delete;
+
+  void Run(Job job, JobCounter *counter = nullptr);
+  void Wait(JobCounter &counter);
+
+  // Splits [0, count) into chunks of chunkSize and calls body(begin, end) for
+  // each, in parallel, returning when all of them are done
+  void ParallelFor(int count, int chunkSize, const std::function<void(int begin, int end)> &body);
+
+  int GetThreadCount() const { return (int)queues.size(); }
+  long long GetStealCount() const { return steals.load(std::memory_order_relaxed); }
+
+private:
+  struct QueuedJob
+  {
+    Job job;
+    JobCounter *counter;
+  };
+
+  struct Queue
+  {
+    std::mutex mutex;
+    std::deque<QueuedJob> jobs;
+  };
+
+  int CurrentQueue() const;
+  bool TryRunOne(int queueIndex);
+  void WorkerLoop(int queueIndex);
+
+  std::vector<std::unique_ptr<Queue>> queues;
+  std::vector<std::thread> workers;
+  std::mutex sleepMutex;
+  std::condition_variable wake;
+  std::atomic<int> queued;
+  std::atomic<long long> steals;
+  bool stopping;
+};
+
+#endif
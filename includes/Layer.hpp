@@ -2,6 +2,7 @@
 #ifdef LAYER_H
 #include <iostream>
 #include <raylib.h>
+#include "TextureCache.hpp"
 
 class Layer
 {
@@ -9,13 +10,15 @@ public:
     Layer(const char *file, float spd, float y, float scl);
     ~Layer();
 
-    void Update();
-    void Draw();
+    const TextureHandle &GetTexture() const { return texture; }
+    float GetSpeed() const { return speed; }
+    float GetYOffset() const { return yOffset; }
+    float GetScale() const { return scale; }
+    float GetDrawScale() const { return scale / texture.GetScale(); } // Of the texture as loaded
 
 private:
-    Texture2D texture;
-    float scrollX;
-    float speed;
+    TextureHandle texture;
+    float speed; // Pixels per second
     float yOffset;
     float scale;
 };
@@ -0,0 +1,60 @@
+#ifndef LAYER_STRIP_HPP
+#define LAYER_STRIP_HPP
+
+#include <raylib.h>
+#include "TextureCache.hpp"
+#include <vector>
+
+class Layer;
+class Gamelayer;
+
+// Several parallax layers that scroll together, baked once into a single
+// render texture and drawn as one repeating quad. The strip is rebaked only
+// when the scale or the set of layers changes.
+class LayerStrip
+{
+public:
+  LayerStrip(float parallaxFactor, float layerScale);
+  ~LayerStrip();
+  LayerStrip(const LayerStrip &) = delete;
+  LayerStrip &operator=(const LayerStrip &) = delete;
+
+  void AddLayer(const TextureHandle &texture, float yOffset);
+  void ClearLayers();
+  void SetScale(float newScale);
+
+  // Scrolls by distance * parallax. Menu strips pass the tick length (their
+  // parallax is a speed in pixels per second), gameplay strips pass how far
+  // the player moved
+  void Update(float distance);
+  void Draw(float alpha = 1.0f);
+
+  float GetParallax() const { return parallax; }
+  float GetWidth() const { return width; }
+  int GetLayerCount() const { return (int)layers.size(); }
+
+  // Group consecutive layers that share a parallax factor and width, keeping
+  // the original back-to-front order
+  static std::vector<LayerStrip *> Build(const std::vector<Gamelayer *> &source);
+  static std::vector<LayerStrip *> Build(const std::vector<Layer *> &source);
+
+private:
+  struct StripLayer
+  {
+    TextureHandle texture;
+    float yOffset;
+  };
+
+  void Bake();
+
+  std::vector<StripLayer> layers;
+  RenderTexture2D target;
+  float parallax;
+  float scale;
+  float width;
+  float scrollX;
+  float prevScrollX; // Scroll at the start of the tick, for interpolation
+  bool dirty;
+};
+
+#endif
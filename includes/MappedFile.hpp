@@ -0,0 +1,40 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Read-only view of a whole file. Where the platform allows it the file is
+// memory-mapped, so pages are only read on first touch and come straight
+// from the OS file cache; otherwise it is read into a buffer once.
+class MappedFile
+{
+public:
+  MappedFile();
+  ~MappedFile();
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  bool Open(const std::string &path);
+  void Close();
+
+  bool IsOpen() const { return data != nullptr; }
+  bool IsMapped() const { return IsOpen() && buffer.empty(); }
+  const uint8_t *GetData() const { return data; }
+  size_t GetSize() const { return size; }
+
+  // Reads one byte per page so later accesses to the range don't fault.
+  // Safe to call from worker threads
+  static void Prefault(const void *start, size_t length);
+
+private:
+  const uint8_t *data;
+  size_t size;
+  std::vector<uint8_t> buffer; // Fallback when mapping fails
+  void *fileHandle;            // Windows only
+  void *mappingHandle;
+};
+
+#endif
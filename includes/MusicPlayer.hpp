@@ -0,0 +1,70 @@
+#ifndef MUSIC_PLAYER_HPP
+#define MUSIC_PLAYER_HPP
+
+#include <raylib.h>
+#include "SpscQueue.hpp"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Music streams refilled on their own thread, so a long frame on the main
+// thread can't starve them. After Start the audio thread is the only one
+// that touches the streams; the game sends it commands through a lock-free
+// queue and never waits on it.
+class MusicPlayer
+{
+public:
+  MusicPlayer();
+  ~MusicPlayer();
+  MusicPlayer(const MusicPlayer &) = delete;
+  MusicPlayer &operator=(const MusicPlayer &) = delete;
+
+  // Before Start. Returns the track id, -1 when the file didn't open
+  int Load(const std::string &path);
+  void Start();
+  void Unload(); // Stops the thread, then unloads every track
+
+  // Main thread only. Commands apply in the order they were sent
+  void Play(int track);
+  void Stop(int track);
+  void SetVolume(int track, float volume);
+  void Fade(int track, float targetVolume, float seconds); // From the current volume
+
+private:
+  enum class CommandType : unsigned char
+  {
+    PLAY,
+    STOP,
+    VOLUME,
+    FADE
+  };
+
+  struct Command
+  {
+    CommandType type;
+    int track;
+    float volume;
+    float seconds;
+  };
+
+  struct Track
+  {
+    Music music;
+    bool playing;
+    float volume;
+    float fadeTarget;
+    float fadeRate; // Volume per second, 0 when not fading
+  };
+
+  void Send(const Command &command);
+  void Apply(const Command &command);
+  void ThreadLoop();
+
+  std::vector<Track> tracks; // Owned by the audio thread while it runs
+  SpscQueue<Command, 64> commands;
+  std::thread thread;
+  std::atomic<bool> running;
+};
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// Scoped timing zones. PROFILE_ZONE("name") times the rest of the enclosing
+// scope on the calling thread; zones nest, and each thread keeps its own
+// event buffer so workers don't contend. Names must be string literals, the
+// pointer identifies the zone.
+//
+// Built with ENABLE_PROFILER undefined (release builds, unless made with
+// PROFILER=TRUE) the macro is empty and nothing is recorded. A zone's stats
+// are kept per parent, so code that runs on workers and on a waiting thread
+// shows up under both.
+#ifdef ENABLE_PROFILER
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(name) ProfileZone PROFILE_CONCAT(profileZone, __LINE__)(name)
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#endif
+
+class ProfileZone
+{
+public:
+  explicit ProfileZone(const char *name);
+  ~ProfileZone();
+  ProfileZone(const ProfileZone &) = delete;
+  ProfileZone &operator=(const ProfileZone &) = delete;
+
+private:
+  const char *name;
+  const char *parent;
+  int64_t start;
+};
+
+// Collects the zones of every thread once per frame into rolling per-zone
+// statistics, draws them as an overlay and writes Chrome trace files
+// (chrome://tracing, Perfetto).
+class Profiler
+{
+public:
+  static int64_t Now(); // Nanoseconds on the profiler clock
+
+  // Closes the frame, call once per frame on the main thread while no zones
+  // are open on other threads
+  static void EndFrame();
+
+  static void ToggleOverlay();
+  static bool IsOverlayVisible();
+  static void DrawOverlay(int x, int y);
+
+  // Records the next frames and writes them to path as trace events
+  static void CaptureTrace(const std::string &path, int frames = 120);
+
+  static void PrintReport(); // Current statistics to stdout
+
+  static bool IsEnabled();
+};
+
+#endif
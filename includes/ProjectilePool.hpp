@@ -0,0 +1,90 @@
+#ifndef PROJECTILE_POOL_HPP
+#define PROJECTILE_POOL_HPP
+
+#include <raylib.h>
+#include "SpriteAtlas.hpp"
+#include "RenderQueue.hpp"
+#include <cstdint>
+#include <vector>
+
+enum class ProjectileType : unsigned char
+{
+  BULLET
+};
+
+const int ProjectileTypeCount = 1;
+
+// Shared by every projectile of one type
+struct ProjectileArchetype
+{
+  const char *sheetPath; // Frames side by side
+  int frameCount;
+  float frameTime; // Seconds per frame
+  float speed;     // Pixels per second
+  int damage;
+};
+
+struct ProjectileStats
+{
+  int active;
+  int capacity;
+  int highWater;   // Most projectiles alive at once since Clear
+  long long spawned;
+  long long overflows; // Spawns dropped because the pool was full
+};
+
+// Fixed capacity storage for projectiles in flight. Fields are kept in
+// parallel arrays over the first `count` slots; spawning appends and
+// despawning moves the last projectile into the freed slot, both O(1).
+// Nothing allocates after construction, a full pool drops new spawns.
+class ProjectilePool
+{
+public:
+  explicit ProjectilePool(int capacity = 256);
+  ProjectilePool(const ProjectilePool &) = delete;
+  ProjectilePool &operator=(const ProjectilePool &) = delete;
+
+  // Sprite sheets for all projectile types, only needed when drawing
+  static void LoadSprites();
+  static void UnloadSprites();
+
+  bool Spawn(ProjectileType type, Vector2 position, int direction);
+  void Despawn(int index);
+  void Clear();
+
+  // Moves, animates and drops projectiles that left the world
+  void Update(float deltaTime, float worldWidth);
+  void Draw(RenderQueue &queue, float alpha = 1.0f) const;
+
+  int GetActiveCount() const { return count; }
+  Vector2 GetPosition(int index) const { return {posX[index], posY[index]}; }
+  Vector2 GetPreviousPosition(int index) const { return {prevX[index], posY[index]}; }
+  Rectangle GetBounds(int index) const;
+  ProjectileType GetType(int index) const { return types[index]; }
+  ProjectileStats GetStats() const;
+  void LogStats() const;
+
+  static const ProjectileArchetype &GetArchetype(ProjectileType type) { return archetypes[(int)type]; }
+
+private:
+  static const ProjectileArchetype archetypes[ProjectileTypeCount];
+  static SpriteRegion sprites[ProjectileTypeCount];
+  static Vector2 frameSizes[ProjectileTypeCount]; // One frame of each sheet
+
+  static void LoadFrameSizes();
+
+  int capacity;
+  int count;
+  std::vector<float> posX, posY;
+  std::vector<float> prevX; // Start of the tick, for interpolation and swept tests
+  std::vector<float> velocityX;
+  std::vector<float> frameTimer;
+  std::vector<uint8_t> frame;
+  std::vector<ProjectileType> types;
+
+  int highWater;
+  long long spawned;
+  long long overflows;
+};
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef RENDER_QUEUE_HPP
+#define RENDER_QUEUE_HPP
+
+#include <raylib.h>
+#include <cstdint>
+#include <vector>
+
+// Draw order buckets, lower layers are drawn first
+enum class RenderLayer : unsigned char
+{
+  ACTORS = 1,
+  PROJECTILES = 2,
+  OVERLAY = 3
+};
+
+struct SpriteCommand
+{
+  Texture2D texture; // id 0 draws a solid rectangle instead
+  Rectangle source;
+  Rectangle dest;
+  Color tint;
+};
+
+// Per-frame sprite queue. Entities submit instead of drawing directly, the
+// queue then sorts by layer, y-depth and texture and draws everything in as
+// few texture switches (raylib batches) as possible.
+class RenderQueue
+{
+public:
+  void Begin();
+  void Submit(RenderLayer layer, float depth, Texture2D texture, Rectangle source, Rectangle dest, Color tint = WHITE);
+  void SubmitRect(RenderLayer layer, float depth, Rectangle rect, Color color);
+  void Flush();
+
+  // Stats of the last Flush
+  int GetDrawCount() const { return drawCount; }
+  int GetBatchCount() const { return batchCount; }
+
+private:
+  void SortKeys();
+
+  std::vector<SpriteCommand> commands;
+  std::vector<uint64_t> keys; // layer | depth | texture | command index
+  std::vector<uint64_t> scratch;
+  int drawCount = 0;
+  int batchCount = 0;
+};
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef RNG_HPP
+#define RNG_HPP
+
+#include <cstdint>
+#include <utility>
+
+// xoshiro128** generator. 16 bytes of state, a few instructions per number
+// and no shared state, so every bot can own one and draw the same sequence
+// whatever thread runs it. Seeds go through SplitMix64 so nearby seeds (or
+// stream ids) still give unrelated sequences.
+class Rng
+{
+public:
+  explicit Rng(uint64_t seed = 1);
+
+  // Independent generator for one stream of a seed, e.g. one per bot
+  static Rng ForStream(uint64_t seed, uint64_t stream);
+
+  uint32_t Next()
+  {
+    uint32_t result = Rotate(state[1] * 5u, 7) * 9u;
+    uint32_t t = state[1] << 9;
+
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3] = Rotate(state[3], 11);
+
+    return result;
+  }
+
+  // Both ends inclusive and swapped when min > max, like GetRandomValue
+  int Range(int min, int max)
+  {
+    if (min > max)
+      std::swap(min, max);
+
+    uint32_t span = (uint32_t)(max - min) + 1u;
+    return min + (int)(((uint64_t)Next() * span) >> 32);
+  }
+
+  // [0, 1) and [min, max)
+  float Float() { return (Next() >> 8) * (1.0f / 16777216.0f); }
+  float Range(float min, float max) { return min + (max - min) * Float(); }
+
+  // Batch, for filling many values in one tight loop
+  void FillRange(int *values, int count, int min, int max);
+
+private:
+  static uint32_t Rotate(uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+
+  uint32_t state[4];
+};
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef SOUND_POOL_HPP
+#define SOUND_POOL_HPP
+
+#include <raylib.h>
+#include <vector>
+
+struct SoundPoolStats
+{
+  int active; // Voices playing right now
+  int maxActive;
+  long long played;
+  long long stolen;  // Voices cut off to make room for a new one
+  long long dropped; // Plays skipped because nothing could be stolen
+};
+
+// Polyphonic playback of short effects. Each effect gets a fixed set of
+// voices, aliases of one loaded sound that share its samples, so a shot
+// can ring out while the next one starts. When an effect has no free voice,
+// or the pool already plays its cap of voices, the new play steals the
+// voice with the lowest priority, oldest first, as long as that priority
+// isn't above its own. Nothing allocates after Add.
+class SoundPool
+{
+public:
+  explicit SoundPool(int maxActiveVoices = 16);
+  ~SoundPool();
+  SoundPool(const SoundPool &) = delete;
+  SoundPool &operator=(const SoundPool &) = delete;
+
+  // Takes ownership of source. Returns the effect id, -1 when source didn't
+  // load. Higher priorities win when voices run out
+  int Add(Sound source, int voiceCount, int priority, float volume = 1.0f);
+  void Unload();
+
+  // Returns false when the play was dropped. Invalid ids are ignored
+  bool Play(int effect);
+  bool IsPlaying(int effect) const;
+  void SetVolume(int effect, float volume); // Applied to every voice once, not per play
+  void SetMaxActiveVoices(int count) { maxActive = count; }
+
+  int GetActiveCount() const;
+  SoundPoolStats GetStats() const;
+  void LogStats() const;
+
+private:
+  struct Effect
+  {
+    int firstVoice;
+    int voiceCount;
+    int priority;
+  };
+
+  struct Voice
+  {
+    Sound sound; // The source for an effect's first voice, aliases after it
+    int effect;
+    long long started; // Play counter when it last started, for age
+  };
+
+  int FindVictim(int firstVoice, int endVoice, int priority) const;
+
+  std::vector<Effect> effects;
+  std::vector<Voice> voices;
+  int maxActive;
+  long long playCount;
+  long long stolen;
+  long long dropped;
+};
+
+#endif
@@ -0,0 +1,128 @@
+#ifndef SPATIAL_GRID_HPP
+#define SPATIAL_GRID_HPP
+
+#include <raylib.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Uniform spatial hash over axis aligned bounds. Items are small dense ids
+// (bot indices) stored in every cell their bounds touch. Update only moves an
+// item between cells when the range of cells it covers changes, so bots that
+// stay inside their cells cost nothing to keep current.
+//
+// With SetBounds the cells become a flat array over that area instead of a
+// hash map; anything outside the area is kept in the border cells.
+class SpatialGrid
+{
+public:
+  explicit SpatialGrid(float cellSize = 256.0f);
+
+  void Clear();
+  void SetBounds(Rectangle area); // Also clears the grid
+  void Insert(int id, Rectangle bounds);
+  void Update(int id, Rectangle bounds);
+  void Remove(int id);
+  bool Contains(int id) const { return id >= 0 && id < (int)items.size() && items[id].inGrid; }
+
+  // Calls visit(id, bounds) once for each item whose bounds overlap the area.
+  // Queries don't modify the grid, so several threads may query at once
+  template <typename Visitor>
+  void QueryRect(Rectangle area, Visitor &&visit) const;
+
+  // Items whose bounds come within radius of center
+  template <typename Visitor>
+  void QueryRadius(Vector2 center, float radius, Visitor &&visit) const;
+
+  void QueryRect(Rectangle area, std::vector<int> &result) const;
+  void QueryRadius(Vector2 center, float radius, std::vector<int> &result) const;
+
+  float GetCellSize() const { return cellSize; }
+  int GetItemCount() const { return itemCount; }
+  int GetCellCount() const { return columns > 0 ? columns * rows : (int)cells.size(); }
+  int GetCellMoves() const { return cellMoves; } // Items that changed cells since Clear
+
+private:
+  struct CellRange
+  {
+    int minX, minY, maxX, maxY;
+    bool operator==(const CellRange &other) const
+    {
+      return minX == other.minX && minY == other.minY && maxX == other.maxX && maxY == other.maxY;
+    }
+  };
+
+  struct Item
+  {
+    Rectangle bounds;
+    CellRange range;
+    bool inGrid;
+  };
+
+  static uint64_t CellKey(int cx, int cy) { return ((uint64_t)(uint32_t)cx << 32) | (uint32_t)cy; }
+  int CellCoord(float v) const { return (int)floorf(v * inverseCellSize); }
+  const std::vector<int> *FindCell(int cx, int cy) const;
+  std::vector<int> &GetCell(int cx, int cy);
+  CellRange RangeOf(Rectangle bounds) const;
+  void AddToCells(int id, const CellRange &range);
+  void RemoveFromCells(int id, const CellRange &range);
+
+  float cellSize;
+  float inverseCellSize;
+  std::vector<Item> items;
+  // Cells stay allocated once used, items moving in and out don't reallocate
+  std::unordered_map<uint64_t, std::vector<int>> cells;
+  std::vector<std::vector<int>> denseCells; // Row major, used when columns > 0
+  Vector2 origin;
+  int columns, rows;
+  int itemCount;
+  int cellMoves;
+};
+
+template <typename Visitor>
+void SpatialGrid::QueryRect(Rectangle area, Visitor &&visit) const
+{
+  CellRange query = RangeOf(area);
+
+  for (int cy = query.minY; cy <= query.maxY; cy++)
+  {
+    for (int cx = query.minX; cx <= query.maxX; cx++)
+    {
+      const std::vector<int> *cell = FindCell(cx, cy);
+      if (cell == nullptr)
+        continue;
+
+      for (int id : *cell)
+      {
+        const Item &item = items[id];
+
+        // An item spanning several cells is reported only from the first
+        // cell it shares with the query
+        if (cx != std::max(item.range.minX, query.minX) || cy != std::max(item.range.minY, query.minY))
+          continue;
+
+        if (CheckCollisionRecs(area, item.bounds))
+          visit(id, item.bounds);
+      }
+    }
+  }
+}
+
+template <typename Visitor>
+void SpatialGrid::QueryRadius(Vector2 center, float radius, Visitor &&visit) const
+{
+  Rectangle area = {center.x - radius, center.y - radius, radius * 2.0f, radius * 2.0f};
+  float radiusSq = radius * radius;
+
+  QueryRect(area, [&](int id, Rectangle bounds)
+            {
+              // Distance from the center to the closest point of the bounds
+              float dx = std::max(std::max(bounds.x - center.x, 0.0f), center.x - (bounds.x + bounds.width));
+              float dy = std::max(std::max(bounds.y - center.y, 0.0f), center.y - (bounds.y + bounds.height));
+              if (dx * dx + dy * dy <= radiusSq)
+                visit(id, bounds); });
+}
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef SPRITE_ATLAS_HPP
+#define SPRITE_ATLAS_HPP
+
+#include <raylib.h>
+#include "TextureCache.hpp"
+#include <string>
+#include <vector>
+
+// A sprite sheet as it is drawn: the texture that holds it and the rectangle
+// the sheet occupies inside that texture. For a standalone file the rectangle
+// is the whole texture, for a packed sheet it is a sub-rect of an atlas page.
+//
+// Sheets are a row of square frames as tall as the sheet. Packed sheets also
+// know the opaque rectangle of every frame, so only that part needs drawing.
+struct SpriteRegion
+{
+  TextureHandle texture;
+  Rectangle source;
+  std::vector<Rectangle> trims; // Opaque part of each frame, relative to the frame. Empty when unknown
+
+  bool IsValid() const { return texture.IsValid(); }
+
+  // Cuts the transparent border off one frame: source is the whole frame as
+  // animation_frame returns it (negative width when mirrored), dest where
+  // the whole frame goes. False when the frame has nothing to draw. Frames
+  // of another size are left as they are
+  bool Trim(Rectangle &source, Rectangle &dest) const;
+
+  // Union of every frame's opaque part, mirrored frames included, as a
+  // fraction of the frame size. The whole frame when unknown
+  Rectangle GetOpaqueBounds() const;
+};
+
+// Character sprite sheets packed into a few large pages so that bots, the
+// player and bullets can share one texture and batch together.
+//
+// The pages and the metadata file are produced offline by Pack (run the game
+// with --pack-atlas, or `make atlas`). When no atlas is present every lookup
+// falls back to the standalone sheet through TextureCache.
+class SpriteAtlas
+{
+public:
+  static bool Load(const std::string &metaPath);
+  static void Unload();
+  static SpriteRegion Acquire(const std::string &path);
+
+  // File that holds the sheet: its atlas page, or the sheet itself. Pages
+  // load on the first Acquire, so this is what to prefetch
+  static std::string GetTexturePath(const std::string &path);
+
+  static bool Pack(const std::vector<std::string> &sheetDirs, const std::string &outDir, int pageSize);
+};
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef SPSC_QUEUE_HPP
+#define SPSC_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+
+// Fixed size ring buffer for exactly one producer thread and one consumer
+// thread. Neither side locks or allocates: each owns one index and only
+// reads the other's, so Push and Pop are a few loads and a store.
+template <typename T, size_t Capacity>
+class SpscQueue
+{
+  static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+  SpscQueue() : head(0), tail(0) {}
+  SpscQueue(const SpscQueue &) = delete;
+  SpscQueue &operator=(const SpscQueue &) = delete;
+
+  // Producer side. False when full, the item is not queued
+  bool Push(const T &item)
+  {
+    size_t t = tail.load(std::memory_order_relaxed);
+    if (t - head.load(std::memory_order_acquire) == Capacity)
+      return false;
+
+    items[t & (Capacity - 1)] = item;
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer side. False when empty
+  bool Pop(T &item)
+  {
+    size_t h = head.load(std::memory_order_relaxed);
+    if (h == tail.load(std::memory_order_acquire))
+      return false;
+
+    item = items[h & (Capacity - 1)];
+    head.store(h + 1, std::memory_order_release);
+    return true;
+  }
+
+private:
+  T items[Capacity];
+  alignas(64) std::atomic<size_t> head; // Next item to pop, written by the consumer
+  alignas(64) std::atomic<size_t> tail; // Next free slot, written by the producer
+};
+
+#endif
@@ -3,7 +3,14 @@
 
 #include "raylib.h"
 
-// Function declaration (not definition)
+// Text with a one pixel outline. Each distinct string, size and color pair
+// is rendered once into a small render texture and drawn as a single quad
+// from then on; the least recently drawn entries are dropped when the cache
+// is full. Rendering a new entry switches render targets, so don't call it
+// inside BeginMode2D
 void DrawTextOutlined(const char *text, int posX, int posY, int fontSize, Color textColor, Color outlineColor);
 
+// Frees the cached textures, call before CloseWindow
+void ClearTextOutlinedCache();
+
 #endif
@@ -0,0 +1,96 @@
+#ifndef TEXTURE_CACHE_HPP
+#define TEXTURE_CACHE_HPP
+
+#include <raylib.h>
+#include <cstddef>
+#include <string>
+
+struct TextureCacheEntry
+{
+  std::string path;
+  Texture2D texture;
+  int refCount;
+  size_t bytes;
+  float scale; // Of the source art, 1 unless it was resampled on load
+};
+
+struct TextureCacheStats
+{
+  int hits;
+  int misses;
+  int resident;        // Textures currently uploaded
+  size_t bytesResident; // Approximate VRAM used by resident textures
+  size_t bytesPeak;     // Most bytesResident since the last ResetPeak
+};
+
+// Ref-counted handle to a cached texture. Copying a handle shares the
+// texture, the last handle released unloads it.
+class TextureHandle
+{
+public:
+  TextureHandle();
+  TextureHandle(const TextureHandle &other);
+  TextureHandle(TextureHandle &&other) noexcept;
+  TextureHandle &operator=(const TextureHandle &other);
+  TextureHandle &operator=(TextureHandle &&other) noexcept;
+  ~TextureHandle();
+
+  const Texture2D &Get() const;
+  bool IsValid() const { return entry != nullptr && entry->texture.id != 0; }
+  int GetWidth() const { return Get().width; }
+  int GetHeight() const { return Get().height; }
+  float GetScale() const { return entry != nullptr ? entry->scale : 1.0f; }
+  void Reset();
+
+private:
+  friend class TextureCache;
+  explicit TextureHandle(TextureCacheEntry *cacheEntry);
+
+  TextureCacheEntry *entry;
+};
+
+// Central texture registry: every file is decoded and uploaded once, no
+// matter how many Bots, Layers or Buttons use it. Files in the AssetArchive
+// come from there, and files it found to be identical share one texture.
+//
+// Art that is always drawn shrunk by the same factor, like the backgrounds
+// at a window smaller than the source art, can be loaded at that scale: it
+// is resampled once instead of being minified every frame, takes a fraction
+// of the VRAM, and doesn't shimmer. Each scale is cached separately, so a
+// new window size gets new textures and the old ones go with their handles.
+class TextureCache
+{
+public:
+  // Scales of 1 or more load the art as it is, it is never enlarged
+  static TextureHandle Acquire(const std::string &path, float scale = 1.0f);
+
+  // Uploads an image decoded elsewhere as the texture for path at scale,
+  // then unloads the image unless the caller still owns its pixels. The
+  // image must already be resampled. When path is already cached the image
+  // is just dropped
+  static TextureHandle Adopt(const std::string &path, Image image, bool owned = true, float scale = 1.0f);
+
+  // A new RGBA8 image of image resampled to scale, with premultiplied
+  // filtering so transparent pixels don't bleed into the edges. Safe to
+  // call from worker threads
+  static Image Resample(const Image &image, float scale);
+  static float GetLoadScale(float scale) { return scale < 1.0f ? scale : 1.0f; }
+
+  // Generate mipmaps for resampled textures, before loading any. Only helps
+  // when they are drawn at other than their load scale
+  static void SetMipmaps(bool enabled);
+
+  static TextureCacheStats GetStats();
+  static void ResetPeak(); // Starts the peak over from what is resident now
+  static void LogStats();
+
+private:
+  friend class TextureHandle;
+  static std::string GetKey(const std::string &path, float scale);
+  static TextureHandle Insert(const std::string &key, Texture2D texture, float scale);
+  static Texture2D Upload(const std::string &path, Image image, bool owned, bool mipmaps);
+  static void Retain(TextureCacheEntry *entry);
+  static void Release(TextureCacheEntry *entry);
+};
+
+#endif
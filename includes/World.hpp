@@ -0,0 +1,59 @@
+#ifndef WORLD_HPP
+#define WORLD_HPP
+
+#include <raylib.h>
+#include "Character.hpp"
+#include "BotPool.hpp"
+#include "ProjectilePool.hpp"
+#include "CombatSystem.hpp"
+#include "FlowField.hpp"
+#include "Input.hpp"
+#include "Rng.hpp"
+#include <vector>
+
+// Gameplay state of the playing scene: the player, the bots and their
+// bullets. Stepping it needs no window, textures or audio, so it runs the
+// same under the renderer and in headless soak runs.
+class World
+{
+public:
+  World();
+  ~World();
+  World(const World &) = delete;
+  World &operator=(const World &) = delete;
+
+  // Equal seeds and inputs give equal runs
+  void Init(float worldWidth, float worldHeight, int botCount, uint64_t seed = 1);
+  void Step(float deltaTime, const InputState &input);
+  void Unload();
+
+  void SpawnBots(int count);
+
+  // Threads for the bot AI pass, null runs it on the calling thread
+  void SetJobSystem(JobSystem *jobSystem) { jobs = jobSystem; }
+
+  Character *GetPlayer() const { return player; }
+  BotPool &GetBots() { return bots; }
+  const BotPool &GetBots() const { return bots; }
+  ProjectilePool &GetProjectiles() { return projectiles; }
+  const ProjectilePool &GetProjectiles() const { return projectiles; }
+  const CombatSystem &GetCombat() const { return combat; }
+  FlowField &GetFlowField() { return flowField; } // Obstacle costs go here
+  const FlowField &GetFlowField() const { return flowField; }
+  Vector2 GetSize() const { return {width, height}; }
+  long long GetTick() const { return tick; }
+  uint32_t GetChecksum() const; // Hash of the simulation state, equal runs give equal sums
+
+private:
+  Character *player;
+  BotPool bots;
+  ProjectilePool projectiles;
+  CombatSystem combat;
+  FlowField flowField; // Toward the player, for chasing bots
+  JobSystem *jobs;
+  Rng rng; // World level draws, bots own their streams
+  float width, height;
+  long long tick;
+};
+
+#endif
@@ -0,0 +1,480 @@
+#include "includes/AssetArchive.hpp"
+#include "includes/MappedFile.hpp"
+#include "includes/Profiler.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <climits>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <unordered_map>
+
+// File layout, little endian:
+//   "MCPK" u32 version, u32 blob count, u32 entry count
+//   per blob: u64 offset, u64 size, u64 pixel hash, u32 width, u32 height, u32 encoding, u32 unused
+//   per entry: u32 blob, u16 path length, path bytes
+//   then the data of every blob, each starting on a 64 byte boundary
+namespace
+{
+  const char magic[4] = {'M', 'C', 'P', 'K'};
+  const uint32_t version = 1;
+  const size_t blobAlignment = 64;
+  const uint32_t maxImageSize = 16384; // Per side, more than any GPU we target takes
+
+  enum Encoding : uint32_t
+  {
+    RAW = 0,
+    QOI = 1 // Chunk stream only, size is in the blob record
+  };
+
+  struct BlobRecord
+  {
+    uint64_t offset;
+    uint64_t size;
+    uint64_t hash;
+    uint32_t width, height;
+    uint32_t encoding;
+    uint32_t unused;
+  };
+  static_assert(sizeof(BlobRecord) == 40, "BlobRecord is written as is");
+
+  MappedFile archive;
+  std::vector<BlobRecord> blobs;
+  std::vector<std::string> canonicalPaths; // First path of each blob
+  std::unordered_map<std::string, uint32_t> entries;
+
+  template <typename T>
+  void Write(std::ofstream &file, const T &value)
+  {
+    file.write(reinterpret_cast<const char *>(&value), sizeof(T));
+  }
+
+  uint64_t HashPixels(const uint8_t *pixels, size_t bytes, int width, int height)
+  {
+    uint64_t hash = 14695981039346656037ull; // FNV-1a
+    hash = (hash ^ (uint64_t)width) * 1099511628211ull;
+    hash = (hash ^ (uint64_t)height) * 1099511628211ull;
+    for (size_t i = 0; i < bytes; i++)
+      hash = (hash ^ pixels[i]) * 1099511628211ull;
+    return hash;
+  }
+
+  // QOI, https://qoiformat.org. Same ops as the reference encoder, without
+  // the file header and end marker since the record has the size
+  const uint8_t QoiIndex = 0x00, QoiDiff = 0x40, QoiLuma = 0x80, QoiRun = 0xc0;
+  const uint8_t QoiRgb = 0xfe, QoiRgba = 0xff;
+
+  int QoiHash(const uint8_t *px)
+  {
+    return (px[0] * 3 + px[1] * 5 + px[2] * 7 + px[3] * 11) % 64;
+  }
+
+  void QoiEncode(const uint8_t *pixels, size_t count, std::vector<uint8_t> &out)
+  {
+    uint8_t index[64][4] = {};
+    uint8_t prev[4] = {0, 0, 0, 255};
+    int run = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+      const uint8_t *px = pixels + i * 4;
+
+      if (memcmp(px, prev, 4) == 0)
+      {
+        run++;
+        if (run == 62 || i == count - 1)
+        {
+          out.push_back(QoiRun | (run - 1));
+          run = 0;
+        }
+        continue;
+      }
+
+      if (run > 0)
+      {
+        out.push_back(QoiRun | (run - 1));
+        run = 0;
+      }
+
+      int slot = QoiHash(px);
+      if (memcmp(index[slot], px, 4) == 0)
+      {
+        out.push_back(QoiIndex | slot);
+      }
+      else
+      {
+        memcpy(index[slot], px, 4);
+
+        if (px[3] == prev[3])
+        {
+          int8_t dr = (int8_t)(px[0] - prev[0]);
+          int8_t dg = (int8_t)(px[1] - prev[1]);
+          int8_t db = (int8_t)(px[2] - prev[2]);
+          int8_t drdg = (int8_t)(dr - dg);
+          int8_t dbdg = (int8_t)(db - dg);
+
+          if (dr > -3 && dr < 2 && dg > -3 && dg < 2 && db > -3 && db < 2)
+          {
+            out.push_back(QoiDiff | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2));
+          }
+          else if (dg > -33 && dg < 32 && drdg > -9 && drdg < 8 && dbdg > -9 && dbdg < 8)
+          {
+            out.push_back(QoiLuma | (dg + 32));
+            out.push_back((drdg + 8) << 4 | (dbdg + 8));
+          }
+          else
+          {
+            out.insert(out.end(), {QoiRgb, px[0], px[1], px[2]});
+          }
+        }
+        else
+        {
+          out.insert(out.end(), {QoiRgba, px[0], px[1], px[2], px[3]});
+        }
+      }
+
+      memcpy(prev, px, 4);
+    }
+  }
+
+  bool QoiDecode(const uint8_t *data, size_t size, uint8_t *pixels, size_t count)
+  {
+    uint8_t index[64][4] = {};
+    uint8_t px[4] = {0, 0, 0, 255};
+    size_t at = 0;
+    int run = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+      if (run > 0)
+      {
+        run--;
+      }
+      else
+      {
+        if (at >= size)
+          return false;
+
+        uint8_t op = data[at++];
+        if (op == QoiRgb)
+        {
+          if (at + 3 > size)
+            return false;
+          memcpy(px, data + at, 3);
+          at += 3;
+        }
+        else if (op == QoiRgba)
+        {
+          if (at + 4 > size)
+            return false;
+          memcpy(px, data + at, 4);
+          at += 4;
+        }
+        else if ((op & 0xc0) == QoiIndex)
+        {
+          memcpy(px, index[op], 4);
+        }
+        else if ((op & 0xc0) == QoiDiff)
+        {
+          px[0] += ((op >> 4) & 3) - 2;
+          px[1] += ((op >> 2) & 3) - 2;
+          px[2] += (op & 3) - 2;
+        }
+        else if ((op & 0xc0) == QoiLuma)
+        {
+          if (at >= size)
+            return false;
+          uint8_t next = data[at++];
+          int dg = (op & 0x3f) - 32;
+          px[0] += dg - 8 + ((next >> 4) & 0x0f);
+          px[1] += dg;
+          px[2] += dg - 8 + (next & 0x0f);
+        }
+        else
+        {
+          run = op & 0x3f;
+        }
+
+        memcpy(index[QoiHash(px)], px, 4);
+      }
+
+      memcpy(pixels + i * 4, px, 4);
+    }
+
+    return true;
+  }
+}
+
+bool AssetArchive::Open(const std::string &archivePath)
+{
+  Close();
+
+  if (!archive.Open(archivePath))
+  {
+    TraceLog(LOG_INFO, "AssetArchive: %s not found, loading loose files", archivePath.c_str());
+    return false;
+  }
+
+  const uint8_t *data = archive.GetData();
+  size_t size = archive.GetSize();
+  size_t at = 0;
+  auto read = [&](void *out, size_t bytes)
+  {
+    if (at + bytes > size)
+      return false;
+    memcpy(out, data + at, bytes);
+    at += bytes;
+    return true;
+  };
+
+  char fileMagic[4];
+  uint32_t fileVersion = 0, blobCount = 0, entryCount = 0;
+  bool ok = read(fileMagic, sizeof(fileMagic)) && memcmp(fileMagic, magic, sizeof(magic)) == 0 &&
+            read(&fileVersion, sizeof(fileVersion)) && fileVersion == version &&
+            read(&blobCount, sizeof(blobCount)) && read(&entryCount, sizeof(entryCount));
+
+  for (uint32_t i = 0; ok && i < blobCount; i++)
+  {
+    BlobRecord blob;
+    ok = read(&blob, sizeof(blob)) && blob.offset <= size && blob.size <= size - blob.offset &&
+         blob.width > 0 && blob.width <= maxImageSize && blob.height > 0 && blob.height <= maxImageSize &&
+         (blob.encoding == QOI || (blob.encoding == RAW && blob.size == (uint64_t)blob.width * blob.height * 4));
+    blobs.push_back(blob);
+  }
+  canonicalPaths.resize(blobs.size());
+
+  for (uint32_t i = 0; ok && i < entryCount; i++)
+  {
+    uint32_t blob = 0;
+    uint16_t length = 0;
+    ok = read(&blob, sizeof(blob)) && blob < blobCount && read(&length, sizeof(length)) && at + length <= size;
+    if (!ok)
+      break;
+
+    std::string path(reinterpret_cast<const char *>(data + at), length);
+    at += length;
+    if (canonicalPaths[blob].empty())
+      canonicalPaths[blob] = path;
+    entries[path] = blob;
+  }
+
+  if (!ok)
+  {
+    TraceLog(LOG_WARNING, "AssetArchive: %s is damaged or from another version, loading loose files", archivePath.c_str());
+    Close();
+    return false;
+  }
+
+  TraceLog(LOG_INFO, "AssetArchive: %d files, %d unique images, %.1f MB %s", (int)entries.size(), (int)blobs.size(),
+           size / (1024.0f * 1024.0f), archive.IsMapped() ? "mapped" : "read");
+  return true;
+}
+
+void AssetArchive::Close()
+{
+  archive.Close();
+  blobs.clear();
+  canonicalPaths.clear();
+  entries.clear();
+}
+
+bool AssetArchive::IsOpen()
+{
+  return archive.IsOpen();
+}
+
+std::string AssetArchive::Resolve(const std::string &path)
+{
+  auto it = entries.find(path);
+  return it != entries.end() ? canonicalPaths[it->second] : path;
+}
+
+bool AssetArchive::GetSize(const std::string &path, int *width, int *height)
+{
+  auto it = entries.find(path);
+  if (it == entries.end())
+    return false;
+
+  *width = (int)blobs[it->second].width;
+  *height = (int)blobs[it->second].height;
+  return true;
+}
+
+Image AssetArchive::GetImage(const std::string &path, bool *borrowed)
+{
+  if (borrowed != nullptr)
+    *borrowed = false;
+
+  auto it = entries.find(path);
+  if (it == entries.end())
+    return {};
+
+  PROFILE_ZONE("AssetArchive::GetImage");
+  const BlobRecord &blob = blobs[it->second];
+  const uint8_t *data = archive.GetData() + blob.offset;
+  size_t count = (size_t)blob.width * blob.height;
+  Image image = {nullptr, (int)blob.width, (int)blob.height, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8};
+
+  if (blob.encoding == RAW)
+  {
+    image.data = const_cast<uint8_t *>(data);
+    if (borrowed != nullptr)
+      *borrowed = true;
+    return image;
+  }
+
+  // Open limits the size, this only guards MemAlloc's unsigned int
+  if (count * 4 > UINT_MAX)
+    return {};
+
+  image.data = MemAlloc((unsigned int)(count * 4));
+  if (image.data == nullptr)
+    return {};
+  if (!QoiDecode(data, (size_t)blob.size, static_cast<uint8_t *>(image.data), count))
+  {
+    TraceLog(LOG_WARNING, "AssetArchive: %s doesn't decode", path.c_str());
+    MemFree(image.data);
+    return {};
+  }
+  return image;
+}
+
+bool AssetArchive::Build(const std::vector<std::string> &sourceDirs, const std::string &archivePath, bool compress)
+{
+  struct PackedBlob
+  {
+    BlobRecord record;
+    Image image;                  // Decoded pixels, kept to confirm hash matches
+    std::vector<uint8_t> encoded; // Empty when stored raw
+  };
+
+  std::vector<std::string> files;
+  for (const std::string &dir : sourceDirs)
+  {
+    if (!std::filesystem::is_directory(dir))
+      continue;
+    for (const auto &entry : std::filesystem::recursive_directory_iterator(dir))
+    {
+      if (entry.is_regular_file() && entry.path().extension() == ".png")
+        files.push_back(entry.path().generic_string());
+    }
+  }
+  std::sort(files.begin(), files.end()); // Stable output between runs
+  files.erase(std::unique(files.begin(), files.end()), files.end());
+
+  std::vector<PackedBlob> packed;
+  std::vector<std::pair<std::string, uint32_t>> paths;
+  std::unordered_multimap<uint64_t, uint32_t> byHash;
+  size_t rawBytes = 0, duplicateBytes = 0;
+
+  for (const std::string &path : files)
+  {
+    Image image = LoadImage(path.c_str());
+    if (image.data == nullptr)
+      continue;
+    ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+
+    size_t bytes = (size_t)image.width * image.height * 4;
+    const uint8_t *pixels = static_cast<const uint8_t *>(image.data);
+    uint64_t hash = HashPixels(pixels, bytes, image.width, image.height);
+    rawBytes += bytes;
+
+    // Same pixels as an earlier file, point at its copy
+    int duplicateOf = -1;
+    auto range = byHash.equal_range(hash);
+    for (auto it = range.first; it != range.second && duplicateOf < 0; it++)
+    {
+      const Image &other = packed[it->second].image;
+      if (other.width == image.width && other.height == image.height && memcmp(other.data, pixels, bytes) == 0)
+        duplicateOf = (int)it->second;
+    }
+
+    if (duplicateOf >= 0)
+    {
+      paths.push_back({path, (uint32_t)duplicateOf});
+      duplicateBytes += bytes;
+      UnloadImage(image);
+      continue;
+    }
+
+    PackedBlob blob = {{0, bytes, hash, (uint32_t)image.width, (uint32_t)image.height, RAW, 0}, image, {}};
+    if (compress)
+    {
+      QoiEncode(pixels, bytes / 4, blob.encoded);
+
+      // Nothing gained, upload it straight from the file instead
+      if (blob.encoded.size() < bytes)
+      {
+        blob.record.size = blob.encoded.size();
+        blob.record.encoding = QOI;
+      }
+      else
+      {
+        blob.encoded.clear();
+      }
+    }
+
+    byHash.insert({hash, (uint32_t)packed.size()});
+    paths.push_back({path, (uint32_t)packed.size()});
+    packed.push_back(std::move(blob));
+  }
+
+  if (packed.empty())
+  {
+    TraceLog(LOG_WARNING, "AssetArchive: no images to pack");
+    return false;
+  }
+
+  // Table of contents first, then the data at aligned offsets
+  size_t offset = sizeof(magic) + sizeof(uint32_t) * 3 + packed.size() * sizeof(BlobRecord);
+  for (const auto &entry : paths)
+    offset += sizeof(uint32_t) + sizeof(uint16_t) + entry.first.size();
+
+  for (PackedBlob &blob : packed)
+  {
+    offset = (offset + blobAlignment - 1) / blobAlignment * blobAlignment;
+    blob.record.offset = offset;
+    offset += blob.record.size;
+  }
+
+  std::ofstream file(archivePath, std::ios::binary);
+  if (!file)
+  {
+    TraceLog(LOG_WARNING, "AssetArchive: can't write %s", archivePath.c_str());
+    for (PackedBlob &blob : packed)
+      UnloadImage(blob.image);
+    return false;
+  }
+
+  file.write(magic, sizeof(magic));
+  Write(file, version);
+  Write(file, (uint32_t)packed.size());
+  Write(file, (uint32_t)paths.size());
+  for (const PackedBlob &blob : packed)
+    Write(file, blob.record);
+  for (const auto &entry : paths)
+  {
+    Write(file, entry.second);
+    Write(file, (uint16_t)entry.first.size());
+    file.write(entry.first.data(), entry.first.size());
+  }
+
+  const char zeros[blobAlignment] = {};
+  size_t packedBytes = 0;
+  for (PackedBlob &blob : packed)
+  {
+    file.write(zeros, blob.record.offset - (size_t)file.tellp());
+    if (blob.encoded.empty())
+      file.write(static_cast<const char *>(blob.image.data), blob.record.size);
+    else
+      file.write(reinterpret_cast<const char *>(blob.encoded.data()), blob.encoded.size());
+    packedBytes += blob.record.size;
+    UnloadImage(blob.image);
+  }
+
+  bool ok = (bool)file;
+  TraceLog(LOG_INFO, "AssetArchive: packed %d files as %d images, %.1f MB of pixels (%.1f MB duplicates) into %.1f MB",
+           (int)paths.size(), (int)packed.size(), rawBytes / (1024.0f * 1024.0f), duplicateBytes / (1024.0f * 1024.0f),
+           packedBytes / (1024.0f * 1024.0f));
+  return ok;
+}
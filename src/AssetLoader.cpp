@@ -0,0 +1,166 @@
+#include "includes/AssetLoader.hpp"
+#include "includes/AssetArchive.hpp"
+#include "includes/MappedFile.hpp"
+#include "includes/Profiler.hpp"
+#include <chrono>
+
+AssetLoader::AssetLoader(JobSystem &jobSystem)
+    : jobs(jobSystem),
+      pending(0),
+      threaded(jobSystem.GetThreadCount() > 1),
+      firstWaiting(0),
+      readyCount(0)
+{
+}
+
+AssetLoader::~AssetLoader()
+{
+  Release();
+}
+
+void AssetLoader::QueueTexture(const std::string &path, float scale)
+{
+  Queue(path, AssetKind::TEXTURE, TextureCache::GetLoadScale(scale));
+}
+
+void AssetLoader::QueueSound(const std::string &path)
+{
+  Queue(path, AssetKind::SOUND, 1.0f);
+}
+
+void AssetLoader::Queue(const std::string &path, AssetKind kind, float scale)
+{
+  std::string key = GetKey(path, scale);
+  if (byPath.count(key) != 0)
+    return;
+
+  assets.push_back(std::unique_ptr<Asset>(new Asset{path, kind, {}, false, scale, {}, {false}, false}));
+  Asset *asset = assets.back().get();
+  byPath[key] = asset;
+
+  if (threaded)
+    jobs.Run([asset]
+             { Decode(*asset); }, &pending);
+}
+
+std::string AssetLoader::GetKey(const std::string &path, float scale)
+{
+  return scale == 1.0f ? path : path + "@" + std::to_string(scale);
+}
+
+// Worker side: file reads and decoding only, nothing that touches the GPU
+// or the audio device
+void AssetLoader::Decode(Asset &asset)
+{
+  PROFILE_ZONE("AssetLoader::Decode");
+  if (asset.kind == AssetKind::TEXTURE)
+  {
+    // Raw packed pixels are uploaded from the mapped file, reading them here
+    // keeps the page faults off the main thread
+    asset.image = AssetArchive::GetImage(asset.path, &asset.borrowed);
+    if (asset.image.data == nullptr)
+      asset.image = LoadImage(asset.path.c_str());
+
+    if (asset.scale != 1.0f && asset.image.data != nullptr)
+    {
+      Image resampled = TextureCache::Resample(asset.image, asset.scale);
+      if (!asset.borrowed)
+        UnloadImage(asset.image);
+      asset.image = resampled;
+      asset.borrowed = false;
+    }
+    else if (asset.borrowed)
+      MappedFile::Prefault(asset.image.data, GetPixelDataSize(asset.image.width, asset.image.height, asset.image.format));
+  }
+  else
+    asset.wave = LoadWave(asset.path.c_str());
+
+  asset.decoded.store(true, std::memory_order_release);
+}
+
+void AssetLoader::Upload(Asset &asset)
+{
+  if (asset.kind == AssetKind::TEXTURE)
+  {
+    textures.push_back(TextureCache::Adopt(asset.path, asset.image, !asset.borrowed, asset.scale));
+    asset.image = {};
+  }
+
+  // Sounds stay as decoded samples until CreateSound
+  asset.ready = true;
+  readyCount++;
+}
+
+void AssetLoader::Update(float budgetMs)
+{
+  PROFILE_ZONE("AssetLoader::Update");
+  using Clock = std::chrono::steady_clock;
+  Clock::time_point start = Clock::now();
+
+  for (size_t i = firstWaiting; i < assets.size(); i++)
+  {
+    Asset &asset = *assets[i];
+    if (asset.ready)
+      continue;
+
+    if (!asset.decoded.load(std::memory_order_acquire))
+    {
+      if (threaded)
+        continue;
+      Decode(asset);
+    }
+
+    Upload(asset);
+
+    if (std::chrono::duration<float, std::milli>(Clock::now() - start).count() >= budgetMs)
+      break;
+  }
+
+  while (firstWaiting < assets.size() && assets[firstWaiting]->ready)
+    firstWaiting++;
+}
+
+void AssetLoader::Finish()
+{
+  jobs.Wait(pending);
+  while (!IsDone())
+    Update(1e9f);
+}
+
+bool AssetLoader::IsReady(const std::string &path, float scale) const
+{
+  auto it = byPath.find(GetKey(path, TextureCache::GetLoadScale(scale)));
+  return it != byPath.end() && it->second->ready;
+}
+
+Sound AssetLoader::CreateSound(const std::string &path) const
+{
+  auto it = byPath.find(path);
+  if (it != byPath.end() && it->second->ready && it->second->wave.data != nullptr)
+    return LoadSoundFromWave(it->second->wave);
+
+  return LoadSound(path.c_str());
+}
+
+void AssetLoader::Release()
+{
+  jobs.Wait(pending);
+
+  for (std::unique_ptr<Asset> &asset : assets)
+  {
+    // Decoded but never uploaded, or sound samples
+    if (asset->decoded.load(std::memory_order_acquire))
+    {
+      if (asset->image.data != nullptr && !asset->borrowed)
+        UnloadImage(asset->image);
+      if (asset->wave.data != nullptr)
+        UnloadWave(asset->wave);
+    }
+  }
+
+  assets.clear();
+  byPath.clear();
+  textures.clear();
+  firstWaiting = 0;
+  readyCount = 0;
+}
@@ -0,0 +1,783 @@
+#include "includes/BotPool.hpp"
+#include "includes/Profiler.hpp"
+#include "raylib.h"
+#include "raymath.h"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+
+namespace
+{
+  const int thinkChunkSize = 256; // Bots per job in the parallel think pass
+
+  // Clip timings are shared by all bot types
+  const Animation idleClip = {0, 7, 0, 0.15f, 0.15f, 1, AnimationType::REPEATING};
+  const Animation walkClip = {0, 9, 0, 0.15f, 0.15f, 1, AnimationType::REPEATING};
+  const Animation runClip = {0, 9, 0, 0.1f, 0.1f, 1, AnimationType::REPEATING};
+  const Animation attackClip = {0, 5, 0, 0.1f, 0.1f, 1, AnimationType::ONESHOT};
+
+  const char *sheets[BotTypeCount][BotClipCount] = {
+      // Idle right, idle left, walk, run, attack
+      {"resource/civillian/civilIdle.png", "resource/civillian/civilIdle2.png", "resource/civillian/civilWalk.png",
+       "resource/civillian/civilRun.png", "resource/civillian/civilIdle.png"},
+      {"resource/thug/thugIdle.png", "resource/thug/thugIdle.png", "resource/thug/thugwalk.png",
+       "resource/thug/thugRun.png", "resource/thug/thugAttack.png"},
+      {"resource/gangster/gangsterIdle.png", "resource/gangster/gangsterIdle2.png", "resource/gangster/gangsterWalk.png",
+       "resource/gangster/gangsterRun.png", "resource/gangster/gangsterAttack.png"},
+      {"resource/police/Idle.png", "resource/police/Idle.png", "resource/police/Walk.png",
+       "resource/police/Run.png", "resource/police/Attack.png"}};
+}
+
+// Indexed by BotType: CIVILIAN, THUG, GANGSTER, SWAT
+BotArchetype BotPool::archetypes[BotTypeCount] = {
+    // Civilian - weak and passive, never attacks or chases but flees quickly
+    {60.0f, 50, 0.0f, 0.0f, 150.0f, 999.0f, 10.0f, 15.0f, 256.0f, 256.0f,
+     {idleClip, idleClip, walkClip, runClip, attackClip}},
+    // Thug - fast and aggressive
+    {120.0f, 100, 100.0f, 300.0f, 200.0f, 0.6f, 4.0f, 15.0f, 256.0f, 256.0f,
+     {idleClip, idleClip, walkClip, runClip, attackClip}},
+    // Gangster - tough and persistent
+    {110.0f, 130, 110.0f, 350.0f, 400.0f, 0.7f, 3.0f, 15.0f, 256.0f, 256.0f,
+     {idleClip, idleClip, walkClip, runClip, attackClip}},
+    // Police - balanced and disciplined
+    {100.0f, 120, 130.0f, 400.0f, 300.0f, 0.5f, 6.0f, 15.0f, 256.0f, 256.0f,
+     {idleClip, idleClip, walkClip, runClip, attackClip}}};
+
+BotSprites BotPool::sprites[BotTypeCount];
+Rectangle BotPool::hitBounds[BotTypeCount] = {{0.0f, 0.0f, 1.0f, 1.0f}, {0.0f, 0.0f, 1.0f, 1.0f},
+                                              {0.0f, 0.0f, 1.0f, 1.0f}, {0.0f, 0.0f, 1.0f, 1.0f}};
+bool BotPool::trimmedBounds = false;
+
+// One generator per bot, so a bot draws the same numbers no matter which
+// thread runs it
+int BotPool::Random(int bot, int min, int max)
+{
+  return rng[bot].Range(min, max);
+}
+
+BotPool::BotPool()
+    : worldSize({960.0f, 540.0f}), // Window size, the world overrides it
+      flowField(nullptr),
+      seed(1),
+      lodSettings{{600.0f, 1200.0f, 2400.0f}, {1, 2, 4, 8}, 0.0f, {0.0f, 0.0f, 960.0f, 540.0f}},
+      lodStats{},
+      lodBias(0),
+      thinkTick(0)
+{
+}
+
+// Sprite sheets per bot type. They come from the sprite atlas (or the shared
+// texture cache) and are only loaded by the renderer, headless runs skip them
+void BotPool::LoadSprites()
+{
+  for (int botType = 0; botType < BotTypeCount; botType++)
+  {
+    for (int clip = 0; clip < BotClipCount; clip++)
+    {
+      sprites[botType].clips[clip] = SpriteAtlas::Acquire(sheets[botType][clip]);
+      if (!sprites[botType].clips[clip].IsValid())
+        TraceLog(LOG_WARNING, "Failed to load %s for bot type %d", sheets[botType][clip], botType);
+    }
+
+    if (!trimmedBounds)
+      continue;
+
+    // Whatever any clip covers in either direction
+    float minX = 1.0f, minY = 1.0f, maxX = 0.0f, maxY = 0.0f;
+    for (const SpriteRegion &clip : sprites[botType].clips)
+    {
+      Rectangle opaque = clip.GetOpaqueBounds();
+      minX = std::min(minX, opaque.x);
+      minY = std::min(minY, opaque.y);
+      maxX = std::max(maxX, opaque.x + opaque.width);
+      maxY = std::max(maxY, opaque.y + opaque.height);
+    }
+    hitBounds[botType] = {minX, minY, maxX - minX, maxY - minY};
+  }
+}
+
+std::vector<std::string> BotPool::GetSheetPaths()
+{
+  std::vector<std::string> paths;
+  for (int botType = 0; botType < BotTypeCount; botType++)
+    for (int clip = 0; clip < BotClipCount; clip++)
+      paths.push_back(sheets[botType][clip]);
+  return paths;
+}
+
+void BotPool::UnloadSprites()
+{
+  for (BotSprites &set : sprites)
+    set = BotSprites();
+  for (Rectangle &bounds : hitBounds)
+    bounds = {0.0f, 0.0f, 1.0f, 1.0f};
+}
+
+// Bots are clamped inside the world, so the grid can be a flat array over it
+void BotPool::SetWorldSize(Vector2 size)
+{
+  worldSize = size;
+  grid.SetBounds({0.0f, 0.0f, size.x, size.y});
+  for (int i = 0; i < GetCount(); i++)
+    SyncGrid(i);
+}
+
+void BotPool::Clear()
+{
+  posX.clear();
+  posY.clear();
+  nextX.clear();
+  nextY.clear();
+  velocityX.clear();
+  velocityY.clear();
+  thinkElapsed.clear();
+  prevX.clear();
+  prevY.clear();
+  stateTimer.clear();
+  attackTimer.clear();
+  spawnTimer.clear();
+  wanderTimer.clear();
+  wanderTime.clear();
+  targetX.clear();
+  targetY.clear();
+  health.clear();
+  types.clear();
+  states.clear();
+  directions.clear();
+  flags.clear();
+  clips.clear();
+  anims.clear();
+  rng.clear();
+  lodLevels.clear();
+  grid.Clear();
+}
+
+void BotPool::Reserve(int count)
+{
+  posX.reserve(count);
+  posY.reserve(count);
+  nextX.reserve(count);
+  nextY.reserve(count);
+  velocityX.reserve(count);
+  velocityY.reserve(count);
+  thinkElapsed.reserve(count);
+  prevX.reserve(count);
+  prevY.reserve(count);
+  stateTimer.reserve(count);
+  attackTimer.reserve(count);
+  spawnTimer.reserve(count);
+  wanderTimer.reserve(count);
+  wanderTime.reserve(count);
+  targetX.reserve(count);
+  targetY.reserve(count);
+  health.reserve(count);
+  types.reserve(count);
+  states.reserve(count);
+  directions.reserve(count);
+  flags.reserve(count);
+  clips.reserve(count);
+  anims.reserve(count);
+  rng.reserve(count);
+  lodLevels.reserve(count);
+}
+
+int BotPool::Spawn(BotType type, float x, float y)
+{
+  const BotArchetype &archetype = archetypes[(int)type];
+
+  posX.push_back(x);
+  posY.push_back(y);
+  nextX.push_back(x);
+  nextY.push_back(y);
+  velocityX.push_back(0.0f);
+  velocityY.push_back(0.0f);
+  thinkElapsed.push_back(0.0f);
+  prevX.push_back(x);
+  prevY.push_back(y);
+  stateTimer.push_back(0.0f);
+  attackTimer.push_back(0.0f);
+  spawnTimer.push_back(0.0f);
+  wanderTimer.push_back(0.0f);
+  wanderTime.push_back(archetype.wanderTime);
+  targetX.push_back(0.0f);
+  targetY.push_back(0.0f);
+  health.push_back(archetype.maxHealth);
+  types.push_back(type);
+  states.push_back(BotState::IDLE);
+  directions.push_back(Direction::RIGHT);
+  flags.push_back(0);
+  clips.push_back(BotClip::IDLE_RIGHT);
+  anims.push_back(archetype.clips[(int)BotClip::IDLE_RIGHT]);
+  lodLevels.push_back(0);
+
+  // Each bot is its own stream of the pool seed
+  rng.push_back(Rng::ForStream(seed, rng.size()));
+
+  return GetCount() - 1;
+}
+
+void BotPool::SetSpawned(int bot, bool spawned)
+{
+  flags[bot] = spawned ? (flags[bot] | SPAWNED) : (flags[bot] & ~SPAWNED);
+  SyncGrid(bot);
+}
+
+// Timers and bounds. Bots wait spawnDelay seconds before they become active
+void BotPool::Integrate(float deltaTime)
+{
+  PROFILE_ZONE("BotPool::Integrate");
+  int count = GetCount();
+
+  // Remember where this tick started so Draw can interpolate
+  std::copy(posX.begin(), posX.end(), prevX.begin());
+  std::copy(posY.begin(), posY.end(), prevY.begin());
+
+  for (int i = 0; i < count; i++)
+  {
+    const BotArchetype &archetype = archetypes[(int)types[i]];
+
+    if (!(flags[i] & SPAWNED))
+    {
+      spawnTimer[i] += deltaTime;
+      if (spawnTimer[i] < archetype.spawnDelay)
+        continue;
+
+      flags[i] |= SPAWNED;
+    }
+
+    attackTimer[i] = std::max(attackTimer[i] - deltaTime, 0.0f);
+
+    // Keep bot within world bounds
+    posX[i] = Clamp(posX[i], 0.0f, worldSize.x - archetype.width);
+    posY[i] = Clamp(posY[i], 0.0f, worldSize.y - archetype.height);
+  }
+}
+
+void BotPool::Animate(float deltaTime)
+{
+  PROFILE_ZONE("BotPool::Animate");
+  int count = GetCount();
+
+  for (int i = 0; i < count; i++)
+  {
+    switch (states[i])
+    {
+    case BotState::IDLE:
+      SetClip(i, directions[i] == Direction::RIGHT ? BotClip::IDLE_RIGHT : BotClip::IDLE_LEFT);
+      break;
+
+    case BotState::WANDERING:
+    case BotState::CHASING:
+    case BotState::FLEEING:
+      SetClip(i, BotClip::WALK);
+      break;
+
+    case BotState::ATTACK:
+      SetClip(i, BotClip::ATTACK);
+      break;
+    }
+
+    Animation_Update(&anims[i], deltaTime);
+
+    if (states[i] == BotState::ATTACK && anims[i].curr >= anims[i].last)
+    {
+      flags[i] &= ~ATTACKING;
+      SetState(i, BotState::IDLE);
+    }
+  }
+}
+
+// Decision making runs in parallel. Bots read everyone's position as it was
+// when the pass started (posX/posY and the grid) and write their own new
+// position into nextX/nextY; everything else a bot writes is its own. The
+// result is the same whatever the thread count.
+//
+// Bots far from the player or off screen only think every few ticks, see
+// LodLevel. In between they keep moving with the velocity of their last
+// decision.
+void BotPool::Think(Vector2 playerPos, float deltaTime, JobSystem *jobs)
+{
+  PROFILE_ZONE("BotPool::Think");
+  int count = GetCount();
+  thinkTick++;
+
+  auto thinkRange = [&](int begin, int end)
+  {
+    PROFILE_ZONE("BotPool::ThinkChunk");
+    for (int i = begin; i < end; i++)
+      ScheduleBot(i, playerPos, deltaTime);
+  };
+
+  auto start = std::chrono::steady_clock::now();
+
+  if (jobs != nullptr)
+    jobs->ParallelFor(count, thinkChunkSize, thinkRange);
+  else
+    thinkRange(0, count);
+
+  float thinkMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+  posX.swap(nextX);
+  posY.swap(nextY);
+
+  lodStats = {};
+  lodStats.bias = lodBias;
+  lodStats.thinkMs = thinkMs;
+
+  for (int i = 0; i < count; i++)
+  {
+    SyncGrid(i);
+
+    if (!(flags[i] & SPAWNED) || health[i] <= 0)
+      continue;
+
+    lodStats.perLevel[lodLevels[i]]++;
+    if (flags[i] & THOUGHT)
+      lodStats.thinking++;
+    else
+      lodStats.coasting++;
+  }
+
+  // Over budget: think less often everywhere. Well under: step back again
+  if (lodSettings.budgetMs > 0.0f)
+  {
+    if (thinkMs > lodSettings.budgetMs && lodBias < BotLodLevels - 1)
+      lodBias++;
+    else if (thinkMs < lodSettings.budgetMs * 0.5f && lodBias > 0)
+      lodBias--;
+  }
+}
+
+// Distance bucket, one level closer when the bot is on screen, then shifted
+// by the budget bias
+int BotPool::LodLevel(int bot, Vector2 playerPos) const
+{
+  float distance = Vector2Distance({posX[bot], posY[bot]}, playerPos);
+  int level = 0;
+  while (level < BotLodLevels - 1 && distance >= lodSettings.distances[level])
+    level++;
+
+  if (level > 0 && CheckCollisionRecs(GetBounds(bot), lodSettings.view))
+    level--;
+
+  return std::min(level + lodBias, BotLodLevels - 1);
+}
+
+void BotPool::ScheduleBot(int i, Vector2 playerPos, float deltaTime)
+{
+  nextX[i] = posX[i];
+  nextY[i] = posY[i];
+  flags[i] &= ~THOUGHT;
+
+  if (!(flags[i] & SPAWNED) || health[i] <= 0)
+    return;
+
+  int level = LodLevel(i, playerPos);
+  int interval = lodSettings.intervals[level];
+  lodLevels[i] = (uint8_t)level;
+  thinkElapsed[i] += deltaTime;
+
+  // Staggered by index so each tick only a slice of a bucket thinks
+  if ((thinkTick + i) % interval != 0)
+  {
+    nextX[i] += velocityX[i] * deltaTime;
+    nextY[i] += velocityY[i] * deltaTime;
+    return;
+  }
+
+  ThinkBot(i, playerPos, deltaTime, thinkElapsed[i]);
+
+  velocityX[i] = (nextX[i] - posX[i]) / deltaTime;
+  velocityY[i] = (nextY[i] - posY[i]) / deltaTime;
+  thinkElapsed[i] = 0.0f;
+  flags[i] |= THOUGHT;
+}
+
+// Priority order: attack, chase, flee, wander. Movement covers deltaTime,
+// timers advance by the time since the bot last thought
+void BotPool::ThinkBot(int i, Vector2 playerPos, float deltaTime, float elapsed)
+{
+  const BotArchetype &archetype = archetypes[(int)types[i]];
+  float distanceToPlayer = Vector2Distance({posX[i], posY[i]}, playerPos);
+  stateTimer[i] += elapsed;
+
+  // Priority 1: Attack if in range and can attack
+  if (distanceToPlayer < archetype.attackRange && CanAttack(i) && archetype.attackRange > 0.0f)
+  {
+    SetState(i, BotState::ATTACK);
+    Attack(i);
+  }
+  // Priority 2: Chase if player is in chase range but not attack range
+  else if (distanceToPlayer < archetype.chaseRange && distanceToPlayer > archetype.attackRange &&
+           archetype.chaseRange > 0.0f)
+  {
+    SetState(i, BotState::CHASING);
+    ChasePlayer(i, playerPos, deltaTime);
+  }
+  // Priority 3: Flee if player is close, civilians always flee, others when low on health
+  else if (distanceToPlayer < archetype.fleeingRange && archetype.fleeingRange > 0.0f &&
+           (types[i] == BotType::CIVILIAN || health[i] < archetype.maxHealth * 0.3f))
+  {
+    SetState(i, BotState::FLEEING);
+    MoveAway(i, playerPos, deltaTime);
+  }
+  // Priority 4: Wander when idle
+  else if (states[i] == BotState::IDLE || states[i] == BotState::WANDERING)
+  {
+    if (states[i] == BotState::IDLE && stateTimer[i] >= wanderTime[i])
+    {
+      SetState(i, BotState::WANDERING);
+      wanderTimer[i] = 0.0f;
+    }
+
+    if (states[i] == BotState::WANDERING)
+    {
+      Wander(i, deltaTime, elapsed);
+
+      // Return to idle after wandering for a while
+      if (stateTimer[i] >= wanderTime[i] * 2.0f)
+        SetState(i, BotState::IDLE);
+    }
+  }
+  else
+  {
+    // Default back to idle if no other conditions are met
+    SetState(i, BotState::IDLE);
+  }
+}
+
+void BotPool::FaceTowards(int bot, float directionX, float threshold)
+{
+  if (directionX < -threshold)
+    directions[bot] = Direction::LEFT;
+  else if (directionX > threshold)
+    directions[bot] = Direction::RIGHT;
+}
+
+void BotPool::ChasePlayer(int bot, Vector2 playerPos, float deltaTime)
+{
+  float speed = archetypes[(int)types[bot]].speed;
+  Vector2 position = {posX[bot], posY[bot]};
+
+  // The shared field routes around obstacles; next to the player, or
+  // without a field, head straight for them
+  Vector2 normalizedDirection = flowField != nullptr ? flowField->Sample(position) : Vector2Zero();
+  if (normalizedDirection.x == 0.0f && normalizedDirection.y == 0.0f)
+    normalizedDirection = Vector2Normalize(Vector2Subtract(playerPos, position));
+
+  Vector2 nextPos = Vector2Add(position, Vector2Scale(normalizedDirection, speed * deltaTime));
+
+  // Check collision with other bots before moving
+  if (!WouldCollideWithBots(bot, nextPos))
+  {
+    // Maintain minimum distance to player to avoid overlapping
+    if (Vector2Distance(nextPos, playerPos) > 70.0f)
+    {
+      nextX[bot] = nextPos.x;
+      nextY[bot] = nextPos.y;
+    }
+  }
+  else
+  {
+    // Try to move around the obstacle, slower when avoiding
+    Vector2 avoidDirection = GetAvoidanceDirection(bot, nextPos);
+    nextX[bot] += avoidDirection.x * speed * 0.5f * deltaTime;
+    nextY[bot] += avoidDirection.y * speed * 0.5f * deltaTime;
+  }
+
+  FaceTowards(bot, normalizedDirection.x, 0.1f);
+}
+
+void BotPool::Wander(int bot, float deltaTime, float elapsed)
+{
+  float &x = nextX[bot];
+  float &y = nextY[bot];
+  wanderTimer[bot] -= elapsed;
+
+  // Set new wander target
+  if (wanderTimer[bot] <= 0.0f || Vector2Distance({x, y}, {targetX[bot], targetY[bot]}) < 15.0f)
+  {
+    int maxAttempts = 10; // Prevent infinite loop
+    bool foundValidTarget = false;
+
+    for (int attempt = 0; attempt < maxAttempts && !foundValidTarget; attempt++)
+    {
+      int wanderType = Random(bot, 0, 2);
+
+      if (wanderType == 0) // Random circular movement
+      {
+        float wanderDistance = Random(bot, 100, 200);
+        float angle = Random(bot, 0, 360) * DEG2RAD;
+
+        targetX[bot] = x + cosf(angle) * wanderDistance;
+        targetY[bot] = y + sinf(angle) * wanderDistance;
+      }
+      else if (wanderType == 1) // Horizontal patrol
+      {
+        float patrolDistance = Random(bot, 150, 300);
+        targetX[bot] = x + (Random(bot, 0, 1) ? patrolDistance : -patrolDistance);
+        targetY[bot] = y + Random(bot, -50, 50);
+      }
+      else // Stay in place occasionally
+      {
+        targetX[bot] = x;
+        targetY[bot] = y;
+        wanderTimer[bot] = Random(bot, 20, 40) / 10.0f;
+        SetState(bot, BotState::IDLE);
+        return;
+      }
+
+      // Clamp to world bounds
+      targetX[bot] = Clamp(targetX[bot], 100.0f, worldSize.x - 100.0f);
+      targetY[bot] = Clamp(targetY[bot], 100.0f, worldSize.y - 100.0f);
+
+      // Check if target position would cause collision
+      if (!WouldCollideWithBots(bot, {targetX[bot], targetY[bot]}))
+      {
+        foundValidTarget = true;
+        wanderTimer[bot] = Random(bot, 30, 80) / 10.0f;
+      }
+    }
+
+    if (!foundValidTarget)
+    {
+      // If no valid target found, just stay idle
+      SetState(bot, BotState::IDLE);
+      return;
+    }
+  }
+
+  // Move towards wander target
+  Vector2 directionToTarget = {targetX[bot] - x, targetY[bot] - y};
+  float distance = Vector2Length(directionToTarget);
+
+  if (distance > 15.0f)
+  {
+    Vector2 normalizedDirection = Vector2Scale(directionToTarget, 1.0f / distance);
+    float wanderSpeed = archetypes[(int)types[bot]].speed * Random(bot, 30, 60) / 100.0f;
+
+    Vector2 nextPos = {
+        x + normalizedDirection.x * wanderSpeed * deltaTime,
+        y + normalizedDirection.y * wanderSpeed * deltaTime};
+
+    // Check collision before moving
+    if (!WouldCollideWithBots(bot, nextPos))
+    {
+      x = nextPos.x;
+      y = nextPos.y;
+      FaceTowards(bot, normalizedDirection.x, 0.3f);
+    }
+    else
+    {
+      // Try to find alternative path
+      Vector2 avoidDirection = GetAvoidanceDirection(bot, nextPos);
+      x += avoidDirection.x * wanderSpeed * 0.3f * deltaTime;
+      y += avoidDirection.y * wanderSpeed * 0.3f * deltaTime;
+    }
+  }
+  else
+  {
+    // Reached target, decide what to do next
+    if (Random(bot, 0, 100) < 40)
+      SetState(bot, BotState::IDLE);
+    else
+      wanderTimer[bot] = 0.0f; // Set new target immediately
+  }
+}
+
+void BotPool::MoveAway(int bot, Vector2 threat, float deltaTime)
+{
+  float speed = archetypes[(int)types[bot]].speed;
+  Vector2 normalizedDirection = Vector2Normalize(Vector2Subtract({posX[bot], posY[bot]}, threat));
+
+  // Move faster when fleeing
+  nextX[bot] += normalizedDirection.x * speed * 1.5f * deltaTime;
+  nextY[bot] += normalizedDirection.y * speed * 1.5f * deltaTime;
+
+  FaceTowards(bot, normalizedDirection.x, 0.1f);
+}
+
+void BotPool::SetState(int bot, BotState newState)
+{
+  if (states[bot] == newState)
+    return;
+
+  states[bot] = newState;
+  stateTimer[bot] = 0.0f;
+
+  if (newState == BotState::WANDERING)
+  {
+    wanderTimer[bot] = 0.0f;
+  }
+  else if (newState == BotState::IDLE)
+  {
+    // Add some randomness to idle time
+    wanderTime[bot] = Random(bot, 20, 60) / 10.0f; // 2-6 seconds idle time
+  }
+}
+
+void BotPool::SetClip(int bot, BotClip clip)
+{
+  if (clips[bot] == clip)
+    return;
+
+  clips[bot] = clip;
+  anims[bot] = archetypes[(int)types[bot]].clips[(int)clip];
+}
+
+void BotPool::Attack(int bot)
+{
+  if (!CanAttack(bot))
+    return;
+
+  flags[bot] |= ATTACKING;
+  attackTimer[bot] = archetypes[(int)types[bot]].attackCooldown;
+
+  // Restart the swing even if the previous one is still playing
+  clips[bot] = BotClip::ATTACK;
+  anims[bot] = archetypes[(int)types[bot]].clips[(int)BotClip::ATTACK];
+}
+
+bool BotPool::CanAttack(int bot) const
+{
+  return attackTimer[bot] <= 0.0f && health[bot] > 0 && (flags[bot] & SPAWNED);
+}
+
+void BotPool::TakeDamage(int bot, int damage)
+{
+  health[bot] = std::max(health[bot] - damage, 0);
+
+  if (health[bot] == 0)
+    SyncGrid(bot);
+}
+
+float BotPool::GetMaxSize()
+{
+  float size = 0.0f;
+  for (const BotArchetype &archetype : archetypes)
+    size = std::max(size, std::max(archetype.width, archetype.height));
+  return size;
+}
+
+int BotPool::GetAliveCount() const
+{
+  return (int)std::count_if(health.begin(), health.end(), [](int hp)
+                            { return hp > 0; });
+}
+
+// Always inside the sprite, so QueryBounds' margin still covers it
+Rectangle BotPool::GetBounds(int bot) const
+{
+  const BotArchetype &archetype = archetypes[(int)types[bot]];
+  const Rectangle &box = hitBounds[(int)types[bot]];
+  return {posX[bot] + box.x * archetype.width, posY[bot] + box.y * archetype.height,
+          box.width * archetype.width, box.height * archetype.height};
+}
+
+Rectangle BotPool::GetCollisionBounds(int bot, Vector2 position) const
+{
+  const BotArchetype &archetype = archetypes[(int)types[bot]];
+  return {position.x, position.y, archetype.width * CollisionScale, archetype.height * CollisionScale};
+}
+
+// Collision avoidance, only bots in the grid cells around the position are looked at.
+// The grid only holds spawned, living bots
+bool BotPool::WouldCollideWithBots(int bot, Vector2 position) const
+{
+  bool collides = false;
+
+  grid.QueryRect(GetCollisionBounds(bot, position), [&](int other, Rectangle)
+                 { collides = collides || other != bot; });
+
+  return collides;
+}
+
+Vector2 BotPool::GetAvoidanceDirection(int bot, Vector2 blockedPosition)
+{
+  Vector2 avoidDirection = {0.0f, 0.0f};
+  int collisionCount = 0;
+  float avoidRange = archetypes[(int)types[bot]].width + 50.0f;
+
+  // Grid bounds start at the bot position, so every position within range
+  // has bounds within range too
+  grid.QueryRadius(blockedPosition, avoidRange, [&](int other, Rectangle)
+                   {
+                     if (other == bot)
+                       return;
+
+                     Vector2 awayFromOther = {blockedPosition.x - posX[other], blockedPosition.y - posY[other]};
+                     float distance = Vector2Length(awayFromOther);
+
+                     // Within avoidance range, skipping exact overlaps to avoid division by zero
+                     if (distance < avoidRange && distance > 0.1f)
+                     {
+                       avoidDirection = Vector2Add(avoidDirection, Vector2Scale(awayFromOther, 1.0f / distance));
+                       collisionCount++;
+                     } });
+
+  if (collisionCount > 0)
+  {
+    avoidDirection = Vector2Scale(avoidDirection, 1.0f / collisionCount); // Average the directions
+    return Vector2Normalize(avoidDirection);
+  }
+
+  // If no specific avoidance direction, try random perpendicular movement
+  float randomAngle = Random(bot, 0, 360) * DEG2RAD;
+  return {cosf(randomAngle), sinf(randomAngle)};
+}
+
+// Only spawned, living bots block others
+void BotPool::SyncGrid(int bot)
+{
+  if ((flags[bot] & SPAWNED) && health[bot] > 0)
+    grid.Update(bot, GetCollisionBounds(bot, {posX[bot], posY[bot]}));
+  else
+    grid.Remove(bot);
+}
+
+// Rendering - sprites are queued, the queue sorts and draws them
+void BotPool::Draw(RenderQueue &queue, float alpha) const
+{
+  PROFILE_ZONE("BotPool::Draw");
+  int count = GetCount();
+
+  for (int i = 0; i < count; i++)
+  {
+    // Not spawned yet or dead, nothing to show
+    if (!(flags[i] & SPAWNED) || health[i] <= 0)
+      continue;
+
+    const BotArchetype &archetype = archetypes[(int)types[i]];
+    const SpriteRegion &sheet = sprites[(int)types[i]].clips[(int)clips[i]];
+    Animation anim = anims[i];
+
+    // Frame size follows from the sheet and the clip length
+    int totalFrames = anim.last - anim.first + 1;
+    int frameWidth = (int)sheet.source.width / totalFrames;
+    int frameHeight = (int)sheet.source.height;
+    Rectangle source = animation_frame(&anim, sheet.source, frameWidth, frameHeight);
+
+    // Idle has separate left and right sheets, everything else is mirrored.
+    // A negative width flips the same frame without sampling its neighbour
+    if (directions[i] == Direction::LEFT && states[i] != BotState::IDLE)
+      source.width = -frameWidth;
+
+    // Blend between the last two ticks so motion is smooth at any refresh rate
+    float drawX = prevX[i] + (posX[i] - prevX[i]) * alpha;
+    float drawY = prevY[i] + (posY[i] - prevY[i]) * alpha;
+    Rectangle dest = {drawX, drawY, archetype.width, archetype.height};
+    float depth = drawY + archetype.height; // Feet position decides who stands in front
+
+    // Only the opaque part of the frame, the rest would be blended for nothing
+    if (sheet.Trim(source, dest))
+      queue.Submit(RenderLayer::ACTORS, depth, sheet.texture.Get(), source, dest);
+
+    // Health bar once damaged
+    if (health[i] < archetype.maxHealth)
+    {
+      float healthPercent = (float)health[i] / archetype.maxHealth;
+      queue.SubmitRect(RenderLayer::OVERLAY, depth, {drawX, drawY - 10, archetype.width * healthPercent, 5}, GREEN);
+      queue.SubmitRect(RenderLayer::OVERLAY, depth, {drawX + archetype.width * healthPercent, drawY - 10, archetype.width * (1 - healthPercent), 5}, RED);
+    }
+  }
+}
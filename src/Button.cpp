@@ -1,12 +1,15 @@
 #include "includes/Button.hpp"
+#include "includes/ImageIndex.hpp"
 
 Button::Button(const char *normalFile, const char *hoverFile, const char *clickFile,
                float scale, bool centered, float yOffset)
 {
-  normalTexture = LoadTexture(normalFile);
-  hoverTexture = LoadTexture(hoverFile);
-  clickTexture = LoadTexture(clickFile);
+  normalTexture = TextureCache::Acquire(normalFile);
+  hoverTexture = TextureCache::Acquire(hoverFile);
+  clickTexture = TextureCache::Acquire(clickFile);
 
+  ImageInfo info = ImageIndex::Get(normalFile);
+  size = {(float)info.width, (float)info.height};
   this->scale = scale;
   isPressed = false;
   hasHoverTexture = true;
@@ -14,8 +17,8 @@ Button::Button(const char *normalFile, const char *hoverFile, const char *clickF
 
   if (centered)
   {
-    position.x = (GetScreenWidth() - normalTexture.width * scale) / 2.0f;
-    position.y = (GetScreenHeight() - normalTexture.height * scale) / 2.0f + yOffset;
+    position = GetCenteredPosition(normalFile, scale);
+    position.y += yOffset;
   }
   else
   {
@@ -23,43 +26,42 @@ Button::Button(const char *normalFile, const char *hoverFile, const char *clickF
   }
 }
 
-Button::~Button()
-{
-  UnloadTexture(normalTexture);
-  if (hasHoverTexture)
-    UnloadTexture(hoverTexture);
-  if (hasClickTexture)
-    UnloadTexture(clickTexture);
-}
-
 void Button::Draw()
 {
-  Texture2D textureToUse = normalTexture;
+  Texture2D textureToUse = normalTexture.Get();
 
   if (isPressed && hasClickTexture)
-    textureToUse = clickTexture;
+    textureToUse = clickTexture.Get();
   else if (IsHovered() && hasHoverTexture)
-    textureToUse = hoverTexture;
+    textureToUse = hoverTexture.Get();
 
   DrawTextureEx(textureToUse, position, 0.0f, scale, WHITE);
 }
 
 void Button::Update()
 {
-  if (isPressed && IsMouseButtonReleased(MOUSE_BUTTON_LEFT))
-    isPressed = false;
+  Update(ReadInput());
 }
 
 bool Button::IsClicked()
 {
-  Vector2 mouse = GetMousePosition();
-  Rectangle bounds = {
-      position.x,
-      position.y,
-      normalTexture.width * scale,
-      normalTexture.height * scale};
+  return IsClicked(ReadInput());
+}
+
+void Button::Update(const InputState &input)
+{
+  if (isPressed && input.primaryReleased)
+    isPressed = false;
+}
 
-  if (CheckCollisionPointRec(mouse, bounds) && IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
+Rectangle Button::GetBounds() const
+{
+  return {position.x, position.y, size.x * scale, size.y * scale};
+}
+
+bool Button::IsClicked(const InputState &input)
+{
+  if (CheckCollisionPointRec(input.mouse, GetBounds()) && input.primaryPressed)
   {
     isPressed = true;
     return true;
@@ -70,23 +72,16 @@ bool Button::IsClicked()
 
 bool Button::IsHovered()
 {
-  Vector2 mouse = GetMousePosition();
-  Rectangle bounds = {
-      position.x,
-      position.y,
-      normalTexture.width * scale,
-      normalTexture.height * scale};
-
-  return CheckCollisionPointRec(mouse, bounds);
+  return CheckCollisionPointRec(GetMousePosition(), GetBounds());
 }
 
+// Only reads the file's size, the texture doesn't have to be loaded
 Vector2 Button::GetCenteredPosition(const char *file, float scale)
 {
-  Texture2D temp = LoadTexture(file);
+  ImageInfo info = ImageIndex::Get(file);
   Vector2 center = {
-      (GetScreenWidth() - temp.width * scale) / 2.0f,
-      (GetScreenHeight() - temp.height * scale) / 2.0f};
-  UnloadTexture(temp);
+      (GetScreenWidth() - info.width * scale) / 2.0f,
+      (GetScreenHeight() - info.height * scale) / 2.0f};
   return center;
 }
 
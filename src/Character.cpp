@@ -1,5 +1,6 @@
 #include "includes/Character.hpp"
-#include "includes/GunFire.hpp"
+#include "includes/Profiler.hpp"
+#include "includes/AssetLoader.hpp"
 #include <raylib.h>
 #include <algorithm>
 
@@ -12,21 +13,23 @@ Character::Character(const std::string &idlePath,
                      const std::string &attack,
                      const std::string &gunshotSoundPath,
                      const std::string &attackSoundPath,
-                     const std::string &bulletPath,
                      float startX,
                      float startY,
                      float characterSpeed)
-    : idleTexture{},
-      idleLeftTexture{},
-      walkTexture{},
-      jumpTexture{},
-      shotTexture{},
-      runTexture{},
-      MeleeTexture{},
-      bulletTexture{},
-      MeleeSound{},
-      gunshotSound{},
-      soundLoaded(false),
+    : sounds(nullptr),
+      gunshotEffect(-1),
+      meleeEffect(-1),
+      idlePath(idlePath),
+      idleLeftPath(idleLeftPath),
+      walkPath(walkPath),
+      runPath(runningPath),
+      shotPath(shot),
+      jumpPath(jump),
+      attackPath(attack),
+      gunshotSoundPath(gunshotSoundPath),
+      attackSoundPath(attackSoundPath),
+      pendingGunshots(0),
+      pendingMelee(0),
       idleRightAnim{},
       idleLeftAnim{},
       walkAnim{},
@@ -39,16 +42,19 @@ Character::Character(const std::string &idlePath,
       width(0),
       height(0),
       speed(characterSpeed),
+      velocityX(0.0f),
+      prevX(startX),
+      prevY(startY),
       direction(RIGHT),
       isWalking(false),
       isRunning(false),
-      isLoaded(true),
+      isLoaded(false),
       isJumping(false),
       isOnGround(true),
       jumpVelocity(0.0f),
-      gravity(0.8f),
+      gravity(2880.0f),
       groundY(startY),
-      jumpSpeed(15.0f),
+      jumpSpeed(900.0f),
       fireTimer(0.0f),
       fireCooldown(0.3f),
       isFiring(false),
@@ -57,202 +63,166 @@ Character::Character(const std::string &idlePath,
       AttackcoolDown(0.5f),
       AttackRange(50.0f),
       AttackDamage(25),
-      HitRegistered(false)
+      HitRegistered(false),
+      worldSize({960.0f, 540.0f}),
+      projectiles(nullptr)
 {
-
   groundY = startY;
 
-  idleTexture = LoadTexture(idlePath.c_str());
-  idleLeftTexture = LoadTexture(idleLeftPath.c_str());
-  walkTexture = LoadTexture(walkPath.c_str());
+  // Set character dimensions
+  width = 128 * 2;
+  height = 128 * 2;
+
+  // Initialize animations
+  idleRightAnim = {0, 4, 0, 0.15f, 0.15f, 1, AnimationType::REPEATING};
+  idleLeftAnim = {0, 4, 0, 0.15f, 0.15f, 1, AnimationType::REPEATING};
+  walkAnim = {0, 5, 0, 0.08f, 0.08f, 1, AnimationType::REPEATING};
+  jumpAnim = {0, 9, 0, 0.1f, 0.1f, 1, AnimationType::ONESHOT};
+  shotAnim = {0, 4, 0, 0.05f, 0.05f, 1, AnimationType::ONESHOT};
+  runAnim = {0, 9, 0, 0.1f, 0.1f, 1, AnimationType::REPEATING};
+  MeleeAnim = {0, 3, 0, 0.1f, 0.1f, 1, AnimationType::ONESHOT};
+};
+
+std::vector<std::string> Character::GetSheetPaths() const
+{
+  std::vector<std::string> paths;
+  for (const std::string *path : {&idlePath, &idleLeftPath, &walkPath, &runPath, &shotPath, &jumpPath, &attackPath})
+  {
+    if (!path->empty())
+      paths.push_back(*path);
+  }
+  return paths;
+}
+
+std::vector<std::string> Character::GetSoundPaths() const
+{
+  std::vector<std::string> paths;
+  for (const std::string *path : {&gunshotSoundPath, &attackSoundPath})
+  {
+    if (!path->empty())
+      paths.push_back(*path);
+  }
+  return paths;
+}
+
+void Character::LoadResources(const AssetLoader *loader)
+{
+  idleTexture = SpriteAtlas::Acquire(idlePath);
+  idleLeftTexture = SpriteAtlas::Acquire(idleLeftPath);
+  walkTexture = SpriteAtlas::Acquire(walkPath);
 
-  if (idleTexture.id == 0)
+  isLoaded = true;
+  if (!idleTexture.IsValid())
   {
     TraceLog(LOG_ERROR, "Failed to load idle texture: %s", idlePath.c_str());
     isLoaded = false;
   }
-  if (idleLeftTexture.id == 0)
+  if (!idleLeftTexture.IsValid())
   {
     TraceLog(LOG_ERROR, "Failed to load idle left texture: %s", idleLeftPath.c_str());
     isLoaded = false;
   }
-  if (walkTexture.id == 0)
+  if (!walkTexture.IsValid())
   {
     TraceLog(LOG_ERROR, "Failed to load walk texture: %s", walkPath.c_str());
     isLoaded = false;
   }
 
-  if (!attack.empty())
+  if (!attackPath.empty())
   {
-    MeleeTexture = LoadTexture(attack.c_str());
-    if (MeleeTexture.id == 0)
+    MeleeTexture = SpriteAtlas::Acquire(attackPath);
+    if (!MeleeTexture.IsValid())
     {
-      TraceLog(LOG_ERROR, "Failed to load melee texture: %s", attack.c_str());
+      TraceLog(LOG_ERROR, "Failed to load melee texture: %s", attackPath.c_str());
     }
   }
-  else
-  {
-    MeleeTexture = {0};
-  }
 
-  if (!runningPath.empty())
+  if (!runPath.empty())
   {
-    runTexture = LoadTexture(runningPath.c_str());
-    if (runTexture.id == 0)
+    runTexture = SpriteAtlas::Acquire(runPath);
+    if (!runTexture.IsValid())
     {
-      TraceLog(LOG_ERROR, "Failed to load running texture: %s", runningPath.c_str());
-      runTexture = {0};
+      TraceLog(LOG_ERROR, "Failed to load running texture: %s", runPath.c_str());
     }
   }
-  else
-  {
-    runTexture = {0};
-  }
 
-  if (!shot.empty())
+  if (!shotPath.empty())
   {
-    shotTexture = LoadTexture(shot.c_str());
-    if (shotTexture.id == 0)
+    shotTexture = SpriteAtlas::Acquire(shotPath);
+    if (!shotTexture.IsValid())
     {
-      TraceLog(LOG_ERROR, "Failed to load shot texture: %s", shot.c_str());
+      TraceLog(LOG_ERROR, "Failed to load shot texture: %s", shotPath.c_str());
     }
   }
-  else
-  {
-    shotTexture = {0};
-  }
 
-  if (!jump.empty())
+  if (!jumpPath.empty())
   {
-    jumpTexture = LoadTexture(jump.c_str());
-    if (jumpTexture.id == 0)
+    jumpTexture = SpriteAtlas::Acquire(jumpPath);
+    if (!jumpTexture.IsValid())
     {
-      TraceLog(LOG_ERROR, "Failed to load jump texture: %s", jump.c_str());
+      TraceLog(LOG_ERROR, "Failed to load jump texture: %s", jumpPath.c_str());
     }
   }
-  else
-  {
-    jumpTexture = {0};
-  }
 
-  if (!bulletPath.empty())
+  // Shots get more voices and win over melee when the pool runs out
+  if (sounds != nullptr && !gunshotSoundPath.empty())
   {
-    bulletTexture = LoadTexture(bulletPath.c_str());
-    if (bulletTexture.id == 0)
-    {
-      TraceLog(LOG_ERROR, "failed to load bullet texture %s", bulletPath.c_str());
-    }
-  }
-  else
-  {
-    bulletTexture = {0};
-  }
-
-  if (!gunshotSoundPath.empty())
-  {
-    gunshotSound = LoadSound(gunshotSoundPath.c_str());
-
-    if (gunshotSound.stream.buffer != nullptr)
-    {
-      soundLoaded = true;
-      SetSoundVolume(gunshotSound, 0.7f);
-    }
-    else
+    Sound gunshot = loader != nullptr ? loader->CreateSound(gunshotSoundPath) : LoadSound(gunshotSoundPath.c_str());
+    gunshotEffect = sounds->Add(gunshot, 4, 2, 0.7f);
+    if (gunshotEffect < 0)
     {
       TraceLog(LOG_ERROR, "Failed to load gunshot sound: %s", gunshotSoundPath.c_str());
-      soundLoaded = false;
     }
   }
 
-  if (!attackSoundPath.empty())
+  if (sounds != nullptr && !attackSoundPath.empty())
   {
-    MeleeSound = LoadSound(attackSoundPath.c_str());
-
-    if (MeleeSound.stream.buffer != nullptr)
-    {
-      soundLoaded = true;
-      SetSoundVolume(MeleeSound, 0.7f);
-    }
-    else
+    Sound melee = loader != nullptr ? loader->CreateSound(attackSoundPath) : LoadSound(attackSoundPath.c_str());
+    meleeEffect = sounds->Add(melee, 2, 1, 0.4f);
+    if (meleeEffect < 0)
     {
-      TraceLog(LOG_ERROR, "Failed to load gunshot sound: %s", attackSoundPath.c_str());
-      soundLoaded = false;
+      TraceLog(LOG_ERROR, "Failed to load melee sound: %s", attackSoundPath.c_str());
     }
   }
-
-  // Set character dimensions
-  width = 128 * 2;
-  height = 128 * 2;
-
-  // Initialize animations
-  idleRightAnim = {0, 4, 0, 0.15f, 0.15f, 1, AnimationType::REPEATING};
-  idleLeftAnim = {0, 4, 0, 0.15f, 0.15f, 1, AnimationType::REPEATING};
-  walkAnim = {0, 5, 0, 0.08f, 0.08f, 1, AnimationType::REPEATING};
-  jumpAnim = {0, 9, 0, 0.1f, 0.1f, 1, AnimationType::ONESHOT};
-  shotAnim = {0, 4, 0, 0.05f, 0.05f, 1, AnimationType::ONESHOT};
-  runAnim = {0, 9, 0, 0.1f, 0.1f, 1, AnimationType::REPEATING};
-  MeleeAnim = {0, 3, 0, 0.1f, 0.1f, 1, AnimationType::ONESHOT};
-};
+}
 
 Character::~Character()
 {
-  // Unload textures
-  if (idleTexture.id != 0)
-    UnloadTexture(idleTexture);
-  if (idleLeftTexture.id != 0)
-    UnloadTexture(idleLeftTexture);
-  if (walkTexture.id != 0)
-    UnloadTexture(walkTexture);
-  if (jumpTexture.id != 0)
-    UnloadTexture(jumpTexture);
-  if (shotTexture.id != 0)
-    UnloadTexture(shotTexture);
-  if (runTexture.id != 0)
-    UnloadTexture(runTexture);
-  if (MeleeTexture.id != 0)
-    UnloadTexture(MeleeTexture);
-  if (bulletTexture.id != 0)
-    UnloadTexture(bulletTexture);
-
-  // Unload sound resource
-  if (soundLoaded)
-  {
-    UnloadSound(gunshotSound);
-    UnloadSound(MeleeSound);
-  }
+  // Sprite sheets are released by their cache handles, sounds by the pool
 }
 
-void Character::Update()
+void Character::Update(float deltaTime)
 {
-  fireTimer -= GetFrameTime();
+  PROFILE_ZONE("Character::Update");
+  // Remember where this tick started so Draw can interpolate
+  prevX = x;
+  prevY = y;
+
+  x += velocityX * deltaTime;
+
+  fireTimer -= deltaTime;
   fireTimer = std::max(fireTimer, 0.0f);
 
-  // Keep character within screen bounds
-  float screenWidth = GetScreenWidth();
+  // Keep character within world bounds
   if (x < 0)
     x = 0;
-  if (x + width > screenWidth)
-    x = screenWidth - width;
-
-  for (auto &bullet : bullets)
-  {
-    bullet.Update();
-  }
-
-  UpdateAnimations();
-  UpdateJumpAnimation();
-  UpdateShotAnimation();
-  UpdateRunAnimation();
-  UpdateAttackAnimation();
+  if (x + width > worldSize.x)
+    x = worldSize.x - width;
+
+  UpdateAnimations(deltaTime);
+  UpdateJumpAnimation(deltaTime);
+  UpdateShotAnimation(deltaTime);
+  UpdateRunAnimation(deltaTime);
+  UpdateAttackAnimation(deltaTime);
 }
 
-void Character::HandleInput()
+void Character::HandleInput(const InputState &input)
 {
   bool wasMoving = false;
 
-  if (IsKeyDown(KEY_D) || IsKeyDown(KEY_RIGHT))
+  if (input.right)
   {
-    if (IsKeyDown(KEY_SPACE))
+    if (input.run)
     {
       direction = RIGHT;
       Run();
@@ -263,9 +233,9 @@ void Character::HandleInput()
     }
     wasMoving = true;
   }
-  else if (IsKeyDown(KEY_A) || IsKeyDown(KEY_LEFT))
+  else if (input.left)
   {
-    if (IsKeyDown(KEY_SPACE))
+    if (input.run)
     {
       direction = LEFT;
       Run();
@@ -282,17 +252,17 @@ void Character::HandleInput()
     StopMoving();
   }
 
-  if (IsKeyDown(KEY_W) || IsKeyDown(KEY_UP))
+  if (input.jump)
   {
     Jump();
   }
 
-  if ((IsKeyDown(KEY_J) || IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) && fireTimer <= 0.0f)
+  if ((input.fire || input.primaryPressed) && fireTimer <= 0.0f)
   {
     Shot();
   }
 
-  if ((IsKeyDown(KEY_K) || IsMouseButtonPressed(MOUSE_BUTTON_RIGHT)) && AttackTimer <= 0.0f)
+  if ((input.melee || input.secondaryPressed) && AttackTimer <= 0.0f)
   {
     Attack();
   }
@@ -312,47 +282,47 @@ void Character::UpdatePosition(float deltaX)
   }
 }
 
-void Character::UpdateAnimations()
+void Character::UpdateAnimations(float deltaTime)
 {
   if (isAttacking)
   {
-    Animation_Update(&MeleeAnim);
+    Animation_Update(&MeleeAnim, deltaTime);
   }
   if (isFiring)
   {
-    Animation_Update(&shotAnim);
+    Animation_Update(&shotAnim, deltaTime);
   }
   else if (isJumping)
   {
-    Animation_Update(&jumpAnim);
+    Animation_Update(&jumpAnim, deltaTime);
   }
   else if (isRunning)
   {
-    Animation_Update(&runAnim);
+    Animation_Update(&runAnim, deltaTime);
   }
   else if (isWalking)
   {
-    Animation_Update(&walkAnim);
+    Animation_Update(&walkAnim, deltaTime);
   }
   else
   {
     if (direction == RIGHT)
     {
-      Animation_Update(&idleRightAnim);
+      Animation_Update(&idleRightAnim, deltaTime);
     }
     else
     {
-      Animation_Update(&idleLeftAnim);
+      Animation_Update(&idleLeftAnim, deltaTime);
     }
   }
 }
 
-void Character::UpdateJumpAnimation()
+void Character::UpdateJumpAnimation(float deltaTime)
 {
   if (isJumping)
   {
-    jumpVelocity += gravity;
-    y += jumpVelocity;
+    jumpVelocity += gravity * deltaTime;
+    y += jumpVelocity * deltaTime;
 
     if (y >= groundY)
     {
@@ -364,19 +334,19 @@ void Character::UpdateJumpAnimation()
   }
 }
 
-void Character::UpdateRunAnimation()
+void Character::UpdateRunAnimation(float deltaTime)
 {
   if (isRunning)
   {
-    Animation_Update(&runAnim);
+    Animation_Update(&runAnim, deltaTime);
   }
 }
 
-void Character::UpdateShotAnimation()
+void Character::UpdateShotAnimation(float deltaTime)
 {
   if (isFiring)
   {
-    fireTimer -= GetFrameTime();
+    fireTimer -= deltaTime;
     if (fireTimer <= 0.0f)
     {
       isFiring = false;
@@ -387,7 +357,7 @@ void Character::UpdateShotAnimation()
   }
 }
 
-void Character::UpdateAttackAnimation()
+void Character::UpdateAttackAnimation(float deltaTime)
 {
   static bool attackMoveApplied = false;
 
@@ -399,7 +369,7 @@ void Character::UpdateAttackAnimation()
       attackMoveApplied = false;
     }
 
-    AttackTimer -= GetFrameTime();
+    AttackTimer -= deltaTime;
 
     if (!attackMoveApplied && AttackTimer <= (AttackcoolDown * 0.6f))
     {
@@ -426,9 +396,10 @@ void Character::UpdateAttackAnimation()
   }
 }
 
+// Movement sets a velocity, Update integrates it with the tick length
 void Character::MoveLeft()
 {
-  x -= speed;
+  velocityX = -speed;
   direction = LEFT;
   isWalking = true;
   isRunning = false;
@@ -437,7 +408,7 @@ void Character::MoveLeft()
 
 void Character::MoveRight()
 {
-  x += speed;
+  velocityX = speed;
   direction = RIGHT;
   isWalking = true;
   isRunning = false;
@@ -446,6 +417,7 @@ void Character::MoveRight()
 
 void Character::StopMoving()
 {
+  velocityX = 0.0f;
   isWalking = false;
   isRunning = false;
   currentMovementSpeed = 0.0f;
@@ -467,14 +439,7 @@ void Character::Jump()
 void Character::Run()
 {
   float runSpeed = speed * 2.0f;
-  if (direction == RIGHT)
-  {
-    x += runSpeed;
-  }
-  else
-  {
-    x -= runSpeed;
-  }
+  velocityX = (direction == RIGHT) ? runSpeed : -runSpeed;
 
   isRunning = true;
   isWalking = false;
@@ -489,8 +454,7 @@ void Character::Shot()
     shotAnim.curr = shotAnim.first;
     shotAnim.duration_left = shotAnim.speed;
 
-    if (soundLoaded)
-      PlaySound(gunshotSound);
+    pendingGunshots++;
 
     float muzzleOffsetX = (direction == Direction::RIGHT) ? (width - 9.0f) : (9.0f);
     float muzzleOffsetY = height / 1.5f;
@@ -499,16 +463,8 @@ void Character::Shot()
         y + muzzleOffsetY};
 
     int dir = (direction == Direction::RIGHT) ? 1 : -1;
-    float spd = 8.0f;
-
-    // Optional: check texture
-    if (bulletTexture.id == 0)
-    {
-      TraceLog(LOG_WARNING, "Bullet texture not loaded!");
-    }
-
-    Gunfire bullet(bulletTexture, pos, spd, dir);
-    bullets.push_back(bullet);
+    if (projectiles != nullptr)
+      projectiles->Spawn(ProjectileType::BULLET, pos, dir);
   }
 }
 
@@ -520,7 +476,7 @@ void Character::Attack()
     AttackTimer = AttackcoolDown;
     MeleeAnim.curr = MeleeAnim.first;
     MeleeAnim.duration_left = MeleeAnim.speed;
-    PlayAttackSound();
+    pendingMelee++;
 
     TraceLog(LOG_INFO, "Attack triggered with forward movement.");
   }
@@ -539,58 +495,47 @@ void Character::ResetAttack()
   MeleeAnim.curr = 0;
 }
 
+// Sounds triggered during the ticks since the last frame. Triggers within
+// one frame would start together, so one voice of each covers them; sounds
+// of earlier frames keep ringing on their own voices
+void Character::PlayPendingSounds()
+{
+  if (pendingGunshots > 0)
+    PlayGunshotSound();
+  if (pendingMelee > 0)
+    PlayAttackSound();
+
+  pendingGunshots = 0;
+  pendingMelee = 0;
+}
+
 void Character::PlayGunshotSound()
 {
-  if (soundLoaded)
-  {
-    if (IsSoundPlaying(gunshotSound))
-    {
-      StopSound(gunshotSound);
-    }
-    PlaySound(gunshotSound);
-  }
+  if (sounds != nullptr)
+    sounds->Play(gunshotEffect);
 }
 
 void Character::PlayAttackSound()
 {
-
-  if (soundLoaded)
-  {
-
-    float originalVolume = 0.7f;
-    SetSoundVolume(MeleeSound, 0.4f);
-
-    if (IsSoundPlaying(MeleeSound))
-    {
-      StopSound(MeleeSound);
-    }
-    PlaySound(MeleeSound);
-
-    SetSoundVolume(MeleeSound, originalVolume);
-  }
+  if (sounds != nullptr)
+    sounds->Play(meleeEffect);
 }
 
 bool Character::IsGunshotPlaying() const
 {
-  if (soundLoaded)
-  {
-    return IsSoundPlaying(gunshotSound);
-  }
-  return false;
+  return sounds != nullptr && sounds->IsPlaying(gunshotEffect);
 }
 
 void Character::SetGunshotVolume(float volume)
 {
-  if (soundLoaded)
-  {
-    SetSoundVolume(gunshotSound, std::clamp(volume, 0.0f, 1.0f));
-  }
+  if (sounds != nullptr)
+    sounds->SetVolume(gunshotEffect, std::clamp(volume, 0.0f, 1.0f));
 }
 
 void Character::SetPosition(float newX, float newY)
 {
-  x = newX;
-  y = newY;
+  x = prevX = newX;
+  y = prevY = newY;
 }
 
 void Character::SetDirection(Direction newDirection)
@@ -606,15 +551,15 @@ void Character::SetSize(float newWidth, float newHeight)
 
 CharacterState Character::GetCurrentState() const
 {
-  if (isAttacking && MeleeTexture.id != 0)
+  if (isAttacking && MeleeTexture.IsValid())
     return CharacterState::ATTACKING;
-  if (isFiring && shotTexture.id != 0)
+  if (isFiring && shotTexture.IsValid())
     return CharacterState::FIRING;
 
-  if (isJumping && jumpTexture.id != 0)
+  if (isJumping && jumpTexture.IsValid())
     return CharacterState::JUMPING;
 
-  if (isRunning && runTexture.id != 0)
+  if (isRunning && runTexture.IsValid())
     return CharacterState::RUNNING;
 
   if (isWalking)
@@ -623,78 +568,78 @@ CharacterState Character::GetCurrentState() const
   return (direction == RIGHT) ? CharacterState::IDLE_RIGHT : CharacterState::IDLE_LEFT;
 }
 
-void Character::GetTextureAndAnimation(Texture2D &texture, Rectangle &source)
+void Character::GetTextureAndAnimation(const SpriteRegion *&sheet, Rectangle &source)
 {
   CharacterState state = GetCurrentState();
 
   switch (state)
   {
   case CharacterState::ATTACKING:
-    texture = MeleeTexture;
-    source = animation_frame(&MeleeAnim, 128, 128);
+    sheet = &MeleeTexture;
+    source = animation_frame(&MeleeAnim, MeleeTexture.source, 128, 128);
     if (direction == LEFT)
       source.width = -source.width;
     break;
   case CharacterState::FIRING:
-    texture = shotTexture;
-    source = animation_frame(&shotAnim, 128, 128);
+    sheet = &shotTexture;
+    source = animation_frame(&shotAnim, shotTexture.source, 128, 128);
     if (direction == LEFT)
       source.width = -source.width;
     break;
 
   case CharacterState::JUMPING:
-    texture = jumpTexture;
-    source = animation_frame(&jumpAnim, 128, 128);
+    sheet = &jumpTexture;
+    source = animation_frame(&jumpAnim, jumpTexture.source, 128, 128);
     source.width = (direction == LEFT) ? -128 : 128;
     break;
 
   case CharacterState::RUNNING:
-    texture = runTexture;
-    source = animation_frame(&runAnim, 128, 128);
+    sheet = &runTexture;
+    source = animation_frame(&runAnim, runTexture.source, 128, 128);
     source.width = (direction == LEFT) ? -128 : 128;
     break;
 
   case CharacterState::WALKING:
-    texture = walkTexture;
-    source = animation_frame(&walkAnim, 128, 128);
+    sheet = &walkTexture;
+    source = animation_frame(&walkAnim, walkTexture.source, 128, 128);
     if (direction == LEFT)
       source.width = -source.width;
     break;
 
   case CharacterState::IDLE_RIGHT:
-    texture = idleTexture;
-    source = animation_frame(&idleRightAnim, 128, 128);
+    sheet = &idleTexture;
+    source = animation_frame(&idleRightAnim, idleTexture.source, 128, 128);
     break;
 
   case CharacterState::IDLE_LEFT:
-    texture = idleLeftTexture;
-    source = animation_frame(&idleLeftAnim, 128, 128);
+    sheet = &idleLeftTexture;
+    source = animation_frame(&idleLeftAnim, idleLeftTexture.source, 128, 128);
     break;
 
   default:
     // Fallback to idle right
-    texture = idleTexture;
-    source = animation_frame(&idleRightAnim, 128, 128);
+    sheet = &idleTexture;
+    source = animation_frame(&idleRightAnim, idleTexture.source, 128, 128);
     break;
   }
 }
 
-void Character::Draw()
+void Character::Draw(RenderQueue &queue, float alpha)
 {
   if (!isLoaded)
     return;
 
-  Texture2D currentTexture;
+  const SpriteRegion *sheet;
   Rectangle source;
 
-  GetTextureAndAnimation(currentTexture, source);
+  GetTextureAndAnimation(sheet, source);
 
-  Rectangle dest = {x, y, width, height};
-  Vector2 origin = {0, 0};
+  // Blend between the last two ticks so motion is smooth at any refresh rate
+  float drawX = prevX + (x - prevX) * alpha;
+  float drawY = prevY + (y - prevY) * alpha;
+  Rectangle dest = {drawX, drawY, width, height};
 
-  DrawTexturePro(currentTexture, source, dest, origin, 0.0f, WHITE);
-  for (auto &bullet : bullets)
-  {
-    bullet.Draw();
-  }
+  // Most of the frame is transparent, only its opaque part is drawn
+  if (sheet->Trim(source, dest))
+    queue.Submit(RenderLayer::ACTORS, drawY + height, sheet->texture.Get(), source, dest);
 }
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include "includes/CombatSystem.hpp"
+#include "includes/Profiler.hpp"
+#include <algorithm>
+
+namespace
+{
+  // Slab test of the segment from -> to against rect. On a hit, t is how far
+  // along the segment it enters (0 at from, 1 at to)
+  bool SegmentHitsRect(Vector2 from, Vector2 to, Rectangle rect, float &t)
+  {
+    float tMin = 0.0f;
+    float tMax = 1.0f;
+    float start[2] = {from.x, from.y};
+    float delta[2] = {to.x - from.x, to.y - from.y};
+    float low[2] = {rect.x, rect.y};
+    float high[2] = {rect.x + rect.width, rect.y + rect.height};
+
+    for (int axis = 0; axis < 2; axis++)
+    {
+      if (delta[axis] == 0.0f)
+      {
+        // Parallel to this slab, either always inside it or never
+        if (start[axis] < low[axis] || start[axis] > high[axis])
+          return false;
+        continue;
+      }
+
+      float inverse = 1.0f / delta[axis];
+      float t1 = (low[axis] - start[axis]) * inverse;
+      float t2 = (high[axis] - start[axis]) * inverse;
+      if (t1 > t2)
+        std::swap(t1, t2);
+
+      tMin = std::max(tMin, t1);
+      tMax = std::min(tMax, t2);
+      if (tMin > tMax)
+        return false;
+    }
+
+    t = tMin;
+    return true;
+  }
+}
+
+void CombatSystem::Resolve(ProjectilePool &projectiles, BotPool &bots)
+{
+  PROFILE_ZONE("CombatSystem::Resolve");
+  damageEvents.clear();
+  stats = {};
+  stats.projectiles = projectiles.GetActiveCount();
+  stats.bots = bots.GetGrid().GetItemCount();
+
+  // Backwards, a despawn moves the last projectile into the freed slot
+  for (int i = projectiles.GetActiveCount() - 1; i >= 0; i--)
+  {
+    Rectangle bounds = projectiles.GetBounds(i);
+    Vector2 halfSize = {bounds.width * 0.5f, bounds.height * 0.5f};
+
+    // Sweep the projectile center over this tick, testing against bot
+    // bounds grown by half the projectile so the whole sprite counts
+    Vector2 previous = projectiles.GetPreviousPosition(i);
+    Vector2 from = {previous.x + halfSize.x, previous.y + halfSize.y};
+    Vector2 to = {bounds.x + halfSize.x, bounds.y + halfSize.y};
+
+    Rectangle swept = {std::min(from.x, to.x) - halfSize.x, std::min(from.y, to.y) - halfSize.y,
+                       fabsf(to.x - from.x) + bounds.width, fabsf(to.y - from.y) + bounds.height};
+
+    int target = -1;
+    float nearest = 2.0f;
+
+    stats.broadphasePairs += bots.QueryBounds(swept, [&](int bot)
+                                              {
+                                                Rectangle hitBox = bots.GetBounds(bot);
+                                                hitBox.x -= halfSize.x;
+                                                hitBox.y -= halfSize.y;
+                                                hitBox.width += bounds.width;
+                                                hitBox.height += bounds.height;
+
+                                                float t;
+                                                stats.narrowTests++;
+                                                if (SegmentHitsRect(from, to, hitBox, t) && t < nearest)
+                                                {
+                                                  nearest = t;
+                                                  target = bot;
+                                                } });
+
+    if (target < 0)
+      continue;
+
+    damageEvents.push_back({target, ProjectilePool::GetArchetype(projectiles.GetType(i)).damage});
+    projectiles.Despawn(i);
+    stats.hits++;
+  }
+
+  // Apply after the sweep so every projectile saw the same bots
+  for (const DamageEvent &event : damageEvents)
+  {
+    if (bots.IsAlive(event.bot))
+      bots.TakeDamage(event.bot, event.damage);
+  }
+}
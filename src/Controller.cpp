@@ -1,11 +1,77 @@
 #include "includes/Controller.hpp"
+#include "includes/Profiler.hpp"
 #include <raylib.h>
+#include <ctime>
+
+namespace
+{
+  const int worldBotCount = 10;
+  const float uploadBudgetMs = 4.0f;    // GPU uploads per frame while assets stream in
+  const int maxSoundVoices = 16;        // Effects playing at once across the whole game
+  const bool backgroundMipmaps = false; // Layers are loaded at the size they are drawn
+  const bool trimmedBotBounds = false;  // Bot hit boxes from their opaque pixels, changes combat
+
+  struct LayerFile
+  {
+    const char *file;
+    float speed; // Parallax factor for main layers
+    float yOffset;
+  };
+
+  const LayerFile menuLayerFiles[] = {
+      {"resource/Sky_pale.png", 6.0f, 0},
+      {"resource/back.png", 30.0f, 0},
+      {"resource/Houses3_pale.png", 60.0f, 70},
+      {"resource/houses1.png", 60.0f, 70},
+      {"resource/minishop&callbox.png", 60.0f, 80},
+      {"resource/road&lamps.png", 60.0f, 75}};
+
+  struct ButtonFiles
+  {
+    const char *normal, *hover, *click;
+  };
+
+  const ButtonFiles startButtonFiles = {"resource/button1.png", "resource/button2.png", "resource/button3.png"};
+  const ButtonFiles exitButtonFiles = {"resource/exit1.png", "resource/exit2.png", "resource/exit3.png"};
+  const ButtonFiles yesButtonFiles = {"resource/yes.png", "resource/yes2.png", "resource/yes3.png"};
+  const ButtonFiles noButtonFiles = {"resource/no.png", "resource/no2.png", "resource/no3.png"};
+  const char *const titleFile = "resource/TitleGame.png";
+  const char *const clickSoundFile = "Audio/start.mp3";
+
+  // Loading screen, streamed first so it can show the progress of the rest
+  const LayerFile gameLayerFiles[] = {
+      {"resource/sky.png", 6.0f, 0},
+      {"resource/houses3.png", 30.0f, 0},
+      {"resource/night2.png", 60.0f, 70},
+      {"resource/night.png", 60.0f, 75},
+      {"resource/road.png", 60.0f, 75},
+      {"resource/crosswalk.png", 60.0f, 70}};
+
+  const LayerFile mainLayerFiles[] = {
+      {"resource/mainsky.png", 0.5f, 0.0f},
+      {"resource/housemain2.png", 0.5f, 0.0f},
+      {"resource/housemain.png", 0.5f, 0.0f},
+      {"resource/housemain1.png", 0.5f, 0.0f},
+      {"resource/fountain&bush.png", 0.5f, 0.0f},
+      {"resource/policebox.png", 0.5f, 0.0f},
+      {"resource/mainroad.png", 0.5f, 0.0f}};
+
+  const char *const stateNames[GamestateCount] = {"MENU", "GAME", "PLAYING"};
+}
+
 Controller::Controller()
+    : loader(jobs),
+      sounds(maxSoundVoices),
+      gameplayLoaded(false),
+      input{},
+      replay(nullptr),
+      replayTick(0)
 {
   startButton = nullptr;
   exitButton = nullptr;
   yesButton = nullptr;
   noButton = nullptr;
+  menuTrack = playingTrack = -1;
 }
 void Controller::Init(int screenW, int screenH, int originalW, int originalH)
 {
@@ -24,73 +90,61 @@ void Controller::Init(int screenW, int screenH, int originalW, int originalH)
 
   currentState = Gamestate::MENU;
 
-  // Load sounds and textures
-  clickSound = LoadSound("Audio/start.mp3");
-  backgroundMusic = LoadMusicStream("Audio/Intro1.mp3");
-  playingMusic = LoadMusicStream("Audio/PlayingSound.mp3");
-  titleTexture = LoadTexture("resource/TitleGame.png");
+  // Pre-decoded images and packed character sheets, both fall back to the
+  // loose files when missing
+  AssetArchive::Open("resource/assets.pak");
+  SpriteAtlas::Load("resource/atlas/sprites.atlas");
+
+  // Only what the menu shows loads up front, decoded in parallel and done
+  // before the first frame. The rest streams in behind it, below
+  TextureCache::SetMipmaps(backgroundMipmaps);
+  PrefetchScene(Gamestate::MENU);
+  loader.Finish();
+  clickSound = loader.CreateSound(clickSoundFile);
+  menuTrack = music.Load("Audio/Intro1.mp3");
+  playingTrack = music.Load("Audio/PlayingSound.mp3");
+  titleTexture = TextureCache::Acquire(titleFile);
   titleScale = scale * 3.0f;
-  titlePosition = {(screenWidth - (titleTexture.width * titleScale)) / 2.0f, 20.0f * scale};
-
-  // Initialize player
-  player = new Character("resource/player/Idle.png",
-                         "resource/player/Idle_2.png",
-                         "resource/player/Walk.png",
-                         "resource/player/Run.png",
-                         "resource/player/Shot.png",
-                         "resource/player/Jump.png",
-                         "resource/player/Attack_1.png",
-                         "Audio/Gun.mp3",
-                         "Audio/Attack.mp3",
-                         "resource/player/bullet.png",
-                         120.0f, 270.0f, 2.0f);
-  player->SetJumpSpeed(15.0f);
-  player->SetGravity(0.8f);
-  player->SetGroundY(270.0f);
-  player->SetFireCooldown(0.3f);
-  player->SetGunshotVolume(0.7f);
+  titlePosition = {(screenWidth - (titleTexture.GetWidth() * titleScale)) / 2.0f, 20.0f * scale};
+
+  // Simulation, then the sprites and sounds to present it
+  // A new seed per session, headless runs and replays pass a fixed one
+  uint64_t seed = replay != nullptr ? replay->GetHeader().seed : (uint64_t)time(nullptr);
+  world.Init((float)screenWidth, (float)screenHeight, worldBotCount, seed);
+  if (!recordPath.empty())
+    recording.Begin({seed, (float)screenWidth, (float)screenHeight, worldBotCount, 0, false});
+  world.SetJobSystem(&jobs);
+
+  // The whole world is on screen for now; far bots may think less often
+  // when the AI pass takes more than 2 ms of the frame. The budget reacts
+  // to wall clock time, which makes the simulation depend on how fast the
+  // machine runs, so recorded and replayed sessions go without it
+  BotLodSettings lod = world.GetBots().GetLodSettings();
+  lod.view = {0.0f, 0.0f, (float)screenWidth, (float)screenHeight};
+  lod.budgetMs = recordPath.empty() && replay == nullptr ? 2.0f : 0.0f;
+  world.GetBots().SetLodSettings(lod);
 
   // Menu Layers
-  menuLayers = {
-      new Layer("resource/Sky_pale.png", 0.1f, 0, scale),
-      new Layer("resource/back.png", 0.5f, 0, scale),
-      new Layer("resource/Houses3_pale.png", 1.0f, 70, scale),
-      new Layer("resource/houses1.png", 1.0f, 70, scale),
-      new Layer("resource/minishop&callbox.png", 1.0f, 80, scale),
-      new Layer("resource/road&lamps.png", 1.0f, 75, scale)};
-
-  // Game Layers
-  gameLayers = {
-      new Layer("resource/sky.png", 0.1f, 0, scale),
-      new Layer("resource/houses3.png", 0.5f, 0, scale),
-      new Layer("resource/night2.png", 1.0f, 70, scale),
-      new Layer("resource/night.png", 1.0f, 75, scale),
-      new Layer("resource/road.png", 1.0f, 75, scale),
-      new Layer("resource/crosswalk.png", 1.0f, 70, scale)};
-
-  // Main Game Layers
-  mainlayers = {
-      new Gamelayer("resource/mainsky.png", 0.0f, scale),
-      new Gamelayer("resource/housemain2.png", 0.0f, scale),
-      new Gamelayer("resource/housemain.png", 0.0f, scale),
-      new Gamelayer("resource/housemain1.png", 0.0f, scale),
-      new Gamelayer("resource/fountain&bush.png", 0.0f, scale),
-      new Gamelayer("resource/policebox.png", 0.0f, scale),
-      new Gamelayer("resource/mainroad.png", 0.0f, scale)};
+  for (const LayerFile &layer : menuLayerFiles)
+    menuLayers.push_back(new Layer(layer.file, layer.speed, layer.yOffset, scale));
+
+  // Layers that scroll together are drawn from one baked strip
+  menuStrips = LayerStrip::Build(menuLayers);
 
   // Buttons
-  startButton = new Button("resource/button1.png", "resource/button2.png", "resource/button3.png", scale * 5.0f, true, 70.0f);
-  exitButton = new Button("resource/exit1.png", "resource/exit2.png", "resource/exit3.png", scale * 5.0f, true, 160.0f);
-  yesButton = new Button("resource/yes.png", "resource/yes2.png", "resource/yes3.png", 2.5f);
-  noButton = new Button("resource/no.png", "resource/no2.png", "resource/no3.png", 2.5f);
+  startButton = new Button(startButtonFiles.normal, startButtonFiles.hover, startButtonFiles.click, scale * 5.0f, true, 70.0f);
+  exitButton = new Button(exitButtonFiles.normal, exitButtonFiles.hover, exitButtonFiles.click, scale * 5.0f, true, 160.0f);
+  yesButton = new Button(yesButtonFiles.normal, yesButtonFiles.hover, yesButtonFiles.click, 2.5f);
+  noButton = new Button(noButtonFiles.normal, noButtonFiles.hover, noButtonFiles.click, 2.5f);
+  loader.Release();
 
   // Init state helpers
-  frameCounter = 0;
+  dotTimer = 0.0f;
   dotCount = 0;
   maxDots = 3;
   animatedText = " ";
-  gameTimer = 0;
-  fadeDuration = 300;
+  gameTimer = 0.0f;
+  fadeDuration = 5.0f;
   fadeOutComplete = false;
   playingMusicStarted = false;
   running = true;
@@ -98,81 +152,269 @@ void Controller::Init(int screenW, int screenH, int originalW, int originalH)
 
   popup = Popup();
 
-  PlayMusicStream(backgroundMusic);
-  SpawnBots(10);
+  // The menu only leads to the loading screen and that only to gameplay,
+  // so both are prefetched while the menu runs, loading screen first
+  PrefetchScene(Gamestate::GAME);
+  PrefetchScene(Gamestate::PLAYING);
+
+  // A replay must not depend on how fast this machine loads
+  if (replay != nullptr)
+  {
+    loader.Finish();
+    StreamAssets();
+  }
+
+  music.Play(menuTrack);
+  music.Start();
+  TextureCache::LogStats();
+  TextureCache::ResetPeak();
+  TraceLog(LOG_INFO, "Startup: menu ready %.0f ms after InitWindow", GetTime() * 1000.0);
+}
+
+Controller::SceneManifest Controller::GetManifest(Gamestate state) const
+{
+  SceneManifest manifest;
+
+  switch (state)
+  {
+  case Gamestate::MENU:
+    for (const LayerFile &layer : menuLayerFiles)
+      manifest.backgrounds.push_back(layer.file);
+    for (const ButtonFiles *button : {&startButtonFiles, &exitButtonFiles, &yesButtonFiles, &noButtonFiles})
+      manifest.textures.insert(manifest.textures.end(), {button->normal, button->hover, button->click});
+    manifest.textures.push_back(titleFile);
+    manifest.sounds.push_back(clickSoundFile);
+    break;
+  case Gamestate::GAME:
+    for (const LayerFile &layer : gameLayerFiles)
+      manifest.backgrounds.push_back(layer.file);
+    break;
+  case Gamestate::PLAYING:
+    for (const LayerFile &layer : mainLayerFiles)
+      manifest.backgrounds.push_back(layer.file);
+    for (const std::string &sheet : world.GetPlayer()->GetSheetPaths())
+      manifest.textures.push_back(SpriteAtlas::GetTexturePath(sheet));
+    for (const std::string &sheet : BotPool::GetSheetPaths())
+      manifest.textures.push_back(SpriteAtlas::GetTexturePath(sheet));
+    for (int type = 0; type < ProjectileTypeCount; type++)
+      manifest.textures.push_back(SpriteAtlas::GetTexturePath(ProjectilePool::GetArchetype((ProjectileType)type).sheetPath));
+    manifest.sounds = world.GetPlayer()->GetSoundPaths();
+    break;
+  }
+
+  return manifest;
+}
+
+void Controller::PrefetchScene(Gamestate state)
+{
+  SceneManifest manifest = GetManifest(state);
+  for (const std::string &texture : manifest.backgrounds)
+    loader.QueueTexture(texture, scale);
+  for (const std::string &texture : manifest.textures)
+    loader.QueueTexture(texture);
+  for (const std::string &sound : manifest.sounds)
+    loader.QueueSound(sound);
+}
+
+// Scenes are never entered twice, so leaving one frees everything only it
+// used. The peak covers the whole time in the state, prefetching included
+void Controller::EnterState(Gamestate state)
+{
+  TextureCacheStats stats = TextureCache::GetStats();
+  TraceLog(LOG_INFO, "Scene %s: peak %.2f MB of textures resident", stateNames[(int)currentState],
+           stats.bytesPeak / (1024.0f * 1024.0f));
+
+  ReleaseScene(currentState);
+  currentState = state;
+  TextureCache::ResetPeak();
+}
+
+void Controller::ReleaseScene(Gamestate state)
+{
+  switch (state)
+  {
+  case Gamestate::MENU:
+    for (LayerStrip *strip : menuStrips)
+      delete strip;
+    menuStrips.clear();
+
+    for (Layer *layer : menuLayers)
+      delete layer;
+    menuLayers.clear();
+
+    delete startButton;
+    delete exitButton;
+    delete yesButton;
+    delete noButton;
+    startButton = exitButton = yesButton = noButton = nullptr;
+    titleTexture.Reset();
+    break;
+  case Gamestate::GAME:
+    for (LayerStrip *strip : gameStrips)
+      delete strip;
+    gameStrips.clear();
+
+    for (Layer *layer : gameLayers)
+      delete layer;
+    gameLayers.clear();
+    break;
+  case Gamestate::PLAYING:
+    for (LayerStrip *strip : mainStrips)
+      delete strip;
+    mainStrips.clear();
+
+    for (Gamelayer *main : mainlayers)
+      delete main;
+    mainlayers.clear();
+
+    BotPool::UnloadSprites();
+    ProjectilePool::UnloadSprites();
+    break;
+  }
 }
 
-void Controller::SpawnBots(int count)
+// Once per rendered frame: upload what the workers decoded and build each
+// scene as soon as all of its textures are in
+void Controller::StreamAssets()
 {
-  bots.clear();
-  for (int i = 0; i < count; ++i)
+  if (gameplayLoaded)
+    return;
+
+  loader.Update(uploadBudgetMs);
+
+  if (gameLayers.empty())
   {
-    float x = GetRandomValue(100, GetScreenWidth() - 300);
-    float y = GetRandomValue(100, GetScreenHeight() - 300);
-    BotType type = static_cast<BotType>(GetRandomValue(0, 3));
-    bots.emplace_back(type, x, y);
+    bool ready = true;
+    for (const LayerFile &layer : gameLayerFiles)
+      ready = ready && loader.IsReady(layer.file, scale);
+
+    if (ready)
+    {
+      for (const LayerFile &layer : gameLayerFiles)
+        gameLayers.push_back(new Layer(layer.file, layer.speed, layer.yOffset, scale));
+      gameStrips = LayerStrip::Build(gameLayers);
+    }
   }
+
+  if (!loader.IsDone())
+    return;
+
+  for (const LayerFile &layer : mainLayerFiles)
+    mainlayers.push_back(new Gamelayer(layer.file, layer.yOffset, scale, layer.speed));
+  mainStrips = LayerStrip::Build(mainlayers);
+
+  world.GetPlayer()->SetSoundPool(&sounds);
+  world.GetPlayer()->LoadResources(&loader);
+  world.GetPlayer()->SetGunshotVolume(0.7f);
+  BotPool::SetTrimmedBounds(trimmedBotBounds);
+  BotPool::LoadSprites();
+  ProjectilePool::LoadSprites();
+
+  // Everything now holds its own handles
+  loader.Release();
+  gameplayLoaded = true;
+  TextureCache::LogStats();
+  TraceLog(LOG_INFO, "Startup: gameplay assets ready %.0f ms after InitWindow, from %s", GetTime() * 1000.0,
+           AssetArchive::IsOpen() ? "the archive" : "loose files");
 }
 
-void Controller::Update()
+// Called once per rendered frame, Update may run zero or several times after
+void Controller::PollInput()
 {
+  if (replay == nullptr)
+    LatchInput(input, ReadInput());
+
+  // Debug keys, outside the simulation input so recordings don't see them
+  if (IsKeyPressed(KEY_F3))
+    Profiler::ToggleOverlay();
+  if (IsKeyPressed(KEY_F4))
+    Profiler::CaptureTrace("profile_trace.json");
+}
+
+void Controller::Update(float deltaTime)
+{
+  PROFILE_ZONE("Controller::Update");
+  if (replay != nullptr)
+  {
+    if (IsReplayFinished())
+      return;
+    input = replay->GetInput(replayTick++);
+  }
+
+  if (!recordPath.empty())
+    recording.Record(input, currentState == Gamestate::PLAYING);
+
   switch (currentState)
   {
   case Gamestate::MENU:
-    UpdateMenu();
+    UpdateMenu(deltaTime);
     break;
   case Gamestate::GAME:
-    UpdateGame();
+    UpdateGame(deltaTime);
     break;
   case Gamestate::PLAYING:
-    UpdatePlaying();
+    UpdatePlaying(deltaTime);
     break;
   default:
     break;
   }
+
+  ClearInputEdges(input);
 }
 
-void Controller::Draw()
+// alpha is how far the current frame sits between the last two ticks
+void Controller::Draw(float alpha)
 {
+  PROFILE_ZONE("Controller::Draw");
+  StreamAssets();
+
+  // Once per frame, so triggers from all of this frame's ticks merge
+  if (currentState == Gamestate::PLAYING)
+    world.GetPlayer()->PlayPendingSounds();
+
   BeginDrawing();
   ClearBackground(RAYWHITE);
 
   switch (currentState)
   {
   case Gamestate::MENU:
-    DrawMenu();
+    DrawMenu(alpha);
     break;
   case Gamestate::GAME:
-    DrawGame();
+    DrawGame(alpha);
     break;
   case Gamestate::PLAYING:
-    DrawPlaying();
+    DrawPlaying(alpha);
     break;
   }
 
+  Profiler::DrawOverlay(10, 10);
+
+  PROFILE_ZONE("EndDrawing");
   EndDrawing();
 }
 
-void Controller::UpdateMenu()
+void Controller::UpdateMenu(float deltaTime)
 {
-  UpdateMusicStream(backgroundMusic);
-  for (Layer *layer : menuLayers)
-    layer->Update();
+  for (LayerStrip *strip : menuStrips)
+    strip->Update(deltaTime);
 
   if (!showExitPop)
   {
-    startButton->Update();
-    exitButton->Update();
+    startButton->Update(input);
+    exitButton->Update(input);
 
-    if (startButton->IsClicked())
+    if (startButton->IsClicked(input))
     {
       PlaySound(clickSound);
-      currentState = Gamestate::GAME;
-      gameTimer = 0;
+      gameTimer = 0.0f;
       fadeOutComplete = false;
+      music.Fade(menuTrack, 0.0f, fadeDuration);
+      EnterState(Gamestate::GAME); // The buttons are gone after this
+      return;
     }
 
-    if (exitButton->IsClicked())
+    if (exitButton->IsClicked(input))
     {
       PlaySound(clickSound);
       showExitPop = true;
@@ -180,129 +422,142 @@ void Controller::UpdateMenu()
   }
 }
 
-void Controller::UpdateGame()
+void Controller::UpdateGame(float deltaTime)
 {
-  for (Layer *layer : gameLayers)
-    layer->Update();
+  for (LayerStrip *strip : gameStrips)
+    strip->Update(deltaTime);
 
-  frameCounter++;
-  if (frameCounter >= 30)
+  dotTimer += deltaTime;
+  if (dotTimer >= 0.5f)
   {
-    frameCounter = 0;
+    dotTimer -= 0.5f;
     dotCount = (dotCount + 1) % (maxDots + 1);
     animatedText = "Please wait" + std::string(dotCount, '.');
   }
 
+  // The music fades on the audio thread over the same time
   if (!fadeOutComplete)
   {
-    gameTimer++;
-    float volume = 1.0f - (float)gameTimer / fadeDuration;
-    SetMusicVolume(backgroundMusic, volume < 0 ? 0 : volume);
-
+    gameTimer += deltaTime;
     if (gameTimer >= fadeDuration)
-    {
       fadeOutComplete = true;
-      currentState = Gamestate::PLAYING;
-    }
+  }
+
+  // Play once the fade is over and everything is loaded. A replay starts
+  // on the tick the recording did
+  bool ready = fadeOutComplete && gameplayLoaded;
+  if (replay != nullptr)
+    ready = replayTick < replay->GetTickCount() && replay->StepsWorld(replayTick);
+
+  if (ready)
+  {
+    fadeOutComplete = true;
+    EnterState(Gamestate::PLAYING);
   }
 }
 
-void Controller::UpdatePlaying()
+void Controller::UpdatePlaying(float deltaTime)
 {
-  player->HandleInput();
-  player->Update();
+  PROFILE_ZONE("Controller::UpdatePlaying");
+  world.Step(deltaTime, input);
 
-  Vector2 playerPos = {player->GetX(), player->GetY()};
-  float deltaTime = GetFrameTime();
+  Character *player = world.GetPlayer();
   float backgroundSpeed = player->GetCurrentMovementSpeed();
-
-  for (Gamelayer *main : mainlayers)
-    main->UpdateLayer(backgroundSpeed);
-
-  for (Bot &bot : bots)
-  {
-    bot.Update();
-    bot.UpdateAI(playerPos, deltaTime);
-  }
+  for (LayerStrip *strip : mainStrips)
+    strip->Update(backgroundSpeed * deltaTime);
 
   if (!playingMusicStarted)
   {
-    StopMusicStream(backgroundMusic);
-    PlayMusicStream(playingMusic);
-    SetMusicVolume(playingMusic, 0.5f);
+    music.Stop(menuTrack);
+    music.SetVolume(playingTrack, 0.5f);
+    music.Play(playingTrack);
     playingMusicStarted = true;
   }
-
-  UpdateMusicStream(playingMusic);
 }
 
-void Controller::DrawMenu()
+void Controller::DrawMenu(float alpha)
 {
-  for (Layer *layer : menuLayers)
-    layer->Draw();
+  for (LayerStrip *strip : menuStrips)
+    strip->Draw(alpha);
 
   startButton->Draw();
   exitButton->Draw();
 
-  DrawTextureEx(titleTexture, titlePosition, 0.0f, titleScale, WHITE);
+  DrawTextureEx(titleTexture.Get(), titlePosition, 0.0f, titleScale, WHITE);
 
   if (showExitPop)
     popup.DrawExitPopup(running, showExitPop, clickSound, *yesButton, *noButton);
 }
 
-void Controller::DrawGame()
+void Controller::DrawGame(float alpha)
 {
-  for (Layer *layer : gameLayers)
-    layer->Draw();
+  for (LayerStrip *strip : gameStrips)
+    strip->Draw(alpha);
 
   DrawTextOutlined(animatedText.c_str(), 350, 270, 40, WHITE, BLACK);
+  if (!gameplayLoaded)
+    DrawTextOutlined(TextFormat("Loading %d%%", (int)(loader.GetProgress() * 100.0f)), 380, 320, 20, WHITE, BLACK);
 
   if (!fadeOutComplete)
   {
-    float alpha = 1.0f - (float)gameTimer / fadeDuration;
-    DrawRectangle(0, 0, screenWidth, screenHeight, Fade(BLACK, alpha));
+    float fade = 1.0f - gameTimer / fadeDuration;
+    DrawRectangle(0, 0, screenWidth, screenHeight, Fade(BLACK, fade));
   }
 }
 
-void Controller::DrawPlaying()
+void Controller::DrawPlaying(float alpha)
 {
-  for (Gamelayer *main : mainlayers)
-    main->Drawlayer();
+  for (LayerStrip *strip : mainStrips)
+    strip->Draw(alpha);
+
+  // Actors and bullets go through the queue so they draw y-sorted and batched
+  renderQueue.Begin();
+  world.GetBots().Draw(renderQueue, alpha);
 
-  for (Bot &bot : bots)
-    bot.Draw();
+  world.GetPlayer()->Draw(renderQueue, alpha);
+  world.GetProjectiles().Draw(renderQueue, alpha);
+  renderQueue.Flush();
 
-  player->Draw();
+  // With the profiler overlay, below the zones so they never overlap
+  if (Profiler::IsOverlayVisible())
+    DrawText(TextFormat("render queue: %d draws in %d batches", renderQueue.GetDrawCount(), renderQueue.GetBatchCount()),
+             10, GetScreenHeight() - 20, 10, YELLOW);
 }
 
 void Controller::Unload()
 {
-  for (Layer *layer : menuLayers)
-    delete layer;
-  menuLayers.clear();
-
-  for (Layer *layer : gameLayers)
-    delete layer;
-  gameLayers.clear();
+  TraceLog(LOG_INFO, "Scene %s: peak %.2f MB of textures resident", stateNames[(int)currentState],
+           TextureCache::GetStats().bytesPeak / (1024.0f * 1024.0f));
 
-  for (Gamelayer *main : mainlayers)
-    delete main;
-  mainlayers.clear();
-  delete player;
-  player = nullptr;
+  for (int state = 0; state < GamestateCount; state++)
+    ReleaseScene((Gamestate)state);
 
-  delete startButton;
-  delete exitButton;
-  delete yesButton;
-  delete noButton;
-
-  startButton = nullptr;
-  exitButton = nullptr;
-  yesButton = nullptr;
-  noButton = nullptr;
+  world.GetProjectiles().LogStats();
 
-  UnloadTexture(titleTexture);
+  // A replay that ran to the end has to finish where the recording did
+  if (!recordPath.empty())
+    recording.SetChecksum(world.GetChecksum());
+  if (IsReplayFinished() && replay->GetHeader().hasChecksum)
+  {
+    uint32_t checksum = world.GetChecksum();
+    if (checksum == replay->GetHeader().checksum)
+      TraceLog(LOG_INFO, "Replay: checksum %08x matches the recording", checksum);
+    else
+      TraceLog(LOG_WARNING, "Replay: checksum %08x, the recording ended on %08x; the replay diverged", checksum,
+               replay->GetHeader().checksum);
+  }
+  world.Unload();
+  loader.Release();
+  sounds.LogStats();
+  sounds.Unload();
+
+  if (!recordPath.empty())
+    recording.Save(recordPath);
+
+  SpriteAtlas::Unload();
+  AssetArchive::Close();
+  ClearTextOutlinedCache();
+  TextureCache::LogStats();
   UnloadSound(clickSound);
-  UnloadMusicStream(backgroundMusic);
-  UnloadMusicStream(playingMusic);
+  music.Unload();
 }
@@ -0,0 +1,291 @@
+#include "includes/FlowField.hpp"
+#include "includes/Profiler.hpp"
+#include "raymath.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace
+{
+  // Entering a cell costs at most 254, so pending cells never span more
+  // than this many buckets and a ring of them is enough
+  const int bucketCount = 256;
+
+  const int rowsPerJob = 16; // Rows per job in the parallel direction pass
+}
+
+FlowField::FlowField(float cellSize)
+    : cellSize(cellSize),
+      inverseCellSize(1.0f / cellSize),
+      origin({0.0f, 0.0f}),
+      columns(0),
+      rows(0),
+      buckets(bucketCount),
+      target({0.0f, 0.0f}),
+      targetCell(-1),
+      rangeCells(0),
+      window{0, 0, -1, -1},
+      hasObstacles(false),
+      dirty(true),
+      rebuildCount(0),
+      lastBuildMs(0.0f)
+{
+}
+
+void FlowField::SetBounds(Rectangle area)
+{
+  origin = {area.x, area.y};
+  columns = std::max(1, (int)ceilf(area.width * inverseCellSize));
+  rows = std::max(1, (int)ceilf(area.height * inverseCellSize));
+
+  size_t cellCount = (size_t)columns * rows;
+  costs.assign(cellCount, 1);
+  integration.assign(cellCount, Unreachable);
+  directions.assign(cellCount, {0.0f, 0.0f});
+  inSight.assign(cellCount, 0);
+  targetCell = -1;
+  window = {0, 0, -1, -1};
+  hasObstacles = false;
+  dirty = true;
+}
+
+// Every cell the area touches gets the cost, 0 is treated as open ground
+void FlowField::SetCost(Rectangle area, uint8_t cost)
+{
+  if (costs.empty())
+    return;
+
+  int first = CellIndex({area.x, area.y});
+  int last = CellIndex({area.x + area.width, area.y + area.height});
+  for (int cy = first / columns; cy <= last / columns; cy++)
+    for (int cx = first % columns; cx <= last % columns; cx++)
+      costs[cy * columns + cx] = std::max(cost, (uint8_t)1);
+
+  hasObstacles = std::any_of(costs.begin(), costs.end(), [](uint8_t c)
+                             { return c > 1; });
+  dirty = true;
+}
+
+void FlowField::ClearCosts()
+{
+  std::fill(costs.begin(), costs.end(), 1);
+  hasObstacles = false;
+  dirty = true;
+}
+
+void FlowField::SetRange(float radius)
+{
+  rangeCells = radius > 0.0f ? (int)ceilf(radius * inverseCellSize) : 0;
+  dirty = true;
+}
+
+// Clears what the last build wrote so cells outside the new window read as
+// unreachable
+void FlowField::ResetWindow()
+{
+  for (int cy = window.minY; cy <= window.maxY; cy++)
+  {
+    int first = cy * columns + window.minX;
+    int last = cy * columns + window.maxX + 1;
+    std::fill(integration.begin() + first, integration.begin() + last, Unreachable);
+    std::fill(directions.begin() + first, directions.begin() + last, Vector2{0.0f, 0.0f});
+    std::fill(inSight.begin() + first, inSight.begin() + last, 0);
+  }
+}
+
+bool FlowField::Update(Vector2 newTarget, JobSystem *jobs)
+{
+  PROFILE_ZONE("FlowField::Update");
+  if (costs.empty())
+    return false;
+
+  // Steering inside the line of sight follows the exact target, the field
+  // itself only depends on its cell
+  target = newTarget;
+
+  // Nothing to route around: drop any old build so Sample returns zero
+  if (!hasObstacles)
+  {
+    ResetWindow();
+    window = {0, 0, -1, -1};
+    targetCell = -1;
+    return false;
+  }
+
+  int cell = CellIndex(newTarget);
+  if (!dirty && cell == targetCell)
+    return false;
+
+  auto start = std::chrono::steady_clock::now();
+
+  ResetWindow();
+  targetCell = cell;
+  dirty = false;
+
+  int tx = cell % columns;
+  int ty = cell / columns;
+  if (rangeCells > 0)
+    window = {std::max(tx - rangeCells, 0), std::max(ty - rangeCells, 0),
+              std::min(tx + rangeCells, columns - 1), std::min(ty + rangeCells, rows - 1)};
+  else
+    window = {0, 0, columns - 1, rows - 1};
+
+  Integrate();
+  MarkSight();
+
+  int windowRows = window.maxY - window.minY + 1;
+  if (jobs != nullptr)
+    jobs->ParallelFor(windowRows, rowsPerJob, [this](int begin, int end)
+                      { BuildDirections(window.minY + begin, window.minY + end); });
+  else
+    BuildDirections(window.minY, window.maxY + 1);
+
+  rebuildCount++;
+  lastBuildMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+  return true;
+}
+
+// Dijkstra with a bucket queue: costs are small integers, so the open list
+// is a ring of buckets indexed by total cost instead of a heap
+void FlowField::Integrate()
+{
+  for (std::vector<int> &bucket : buckets)
+    bucket.clear();
+
+  integration[targetCell] = 0;
+  buckets[0].push_back(targetCell);
+  int pending = 1;
+
+  for (uint32_t current = 0; pending > 0; current++)
+  {
+    std::vector<int> &bucket = buckets[current % bucketCount];
+    while (!bucket.empty())
+    {
+      int cell = bucket.back();
+      bucket.pop_back();
+      pending--;
+
+      // Left behind when the cell was reached more cheaply later
+      if (integration[cell] != current)
+        continue;
+
+      int cx = cell % columns;
+      int cy = cell / columns;
+      const int neighbours[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+      for (const int *offset : neighbours)
+      {
+        int nx = cx + offset[0];
+        int ny = cy + offset[1];
+        if (nx < window.minX || ny < window.minY || nx > window.maxX || ny > window.maxY)
+          continue;
+
+        int next = ny * columns + nx;
+        if (costs[next] == Blocked)
+          continue;
+
+        uint32_t total = current + costs[next];
+        if (total < integration[next])
+        {
+          integration[next] = total;
+          buckets[total % bucketCount].push_back(next);
+          pending++;
+        }
+      }
+    }
+  }
+}
+
+// A cell sees the target when it is open and its neighbours one step closer
+// on each axis see it too, so the whole rectangle between them is open.
+// Stricter than a real line of sight but never wrong. Visits rows and then
+// columns outward from the target so those neighbours come first
+void FlowField::MarkSight()
+{
+  int tx = targetCell % columns;
+  int ty = targetCell / columns;
+
+  int reachY = std::max(ty - window.minY, window.maxY - ty);
+  int reachX = std::max(tx - window.minX, window.maxX - tx);
+
+  for (int dy = 0; dy <= reachY; dy++)
+  {
+    for (int sy = -1; sy <= 1; sy += 2)
+    {
+      int cy = ty + dy * sy;
+      if (cy < window.minY || cy > window.maxY || (dy == 0 && sy > 0))
+        continue;
+
+      for (int dx = 0; dx <= reachX; dx++)
+      {
+        for (int sx = -1; sx <= 1; sx += 2)
+        {
+          int cx = tx + dx * sx;
+          if (cx < window.minX || cx > window.maxX || (dx == 0 && sx > 0))
+            continue;
+
+          int cell = cy * columns + cx;
+          bool visible = costs[cell] != Blocked;
+          if (dx > 0)
+            visible = visible && inSight[cell - sx];
+          if (dy > 0)
+            visible = visible && inSight[cell - sy * columns];
+          if (dx > 0 && dy > 0)
+            visible = visible && inSight[cell - sy * columns - sx];
+
+          inSight[cell] = visible;
+        }
+      }
+    }
+  }
+}
+
+// Points each cell at its cheapest neighbour. Diagonals don't cut past
+// blocked corners
+void FlowField::BuildDirections(int firstRow, int lastRow)
+{
+  for (int cy = firstRow; cy < lastRow; cy++)
+  {
+    for (int cx = window.minX; cx <= window.maxX; cx++)
+    {
+      int cell = cy * columns + cx;
+      directions[cell] = {0.0f, 0.0f};
+      if (integration[cell] == Unreachable || cell == targetCell)
+        continue;
+
+      uint32_t best = integration[cell];
+      for (int oy = -1; oy <= 1; oy++)
+      {
+        for (int ox = -1; ox <= 1; ox++)
+        {
+          int nx = cx + ox;
+          int ny = cy + oy;
+          if ((ox == 0 && oy == 0) || nx < window.minX || ny < window.minY || nx > window.maxX || ny > window.maxY)
+            continue;
+
+          if (ox != 0 && oy != 0 &&
+              (costs[cy * columns + nx] == Blocked || costs[ny * columns + cx] == Blocked))
+            continue;
+
+          uint32_t value = integration[ny * columns + nx];
+          if (value < best)
+          {
+            best = value;
+            directions[cell] = Vector2Normalize({(float)ox, (float)oy});
+          }
+        }
+      }
+    }
+  }
+}
+
+Vector2 FlowField::Sample(Vector2 position) const
+{
+  if (targetCell < 0)
+    return {0.0f, 0.0f};
+
+  int cell = CellIndex(position);
+  if (inSight[cell])
+    return Vector2Normalize(Vector2Subtract(target, position));
+
+  return directions[cell];
+}
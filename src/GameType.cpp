@@ -1,9 +1,7 @@
 #include "includes/GameType.hpp"
-#include "includes/Layer.hpp"
 
-void Animation_Update(Animation *self)
+void Animation_Update(Animation *self, float deltaTime)
 {
-  float deltaTime = GetFrameTime();
   self->duration_left -= deltaTime;
 
   if (self->duration_left <= 0.0f)
@@ -45,11 +43,11 @@ Rectangle animation_frame(Animation *self, int frame_width, int frame_height)
   return Rectangle{(float)x, (float)y, (float)frame_width, (float)frame_height};
 }
 
-void UpdateAndDrawLayers(const std::vector<Layer *> &layers)
+// Same as above for a sheet that lives inside a larger texture (atlas page)
+Rectangle animation_frame(Animation *self, Rectangle sheet, int frame_width, int frame_height)
 {
-  for (Layer *layer : layers)
-  {
-    layer->Update();
-    layer->Draw();
-  }
+  Rectangle frame = animation_frame(self, frame_width, frame_height);
+  frame.x += sheet.x;
+  frame.y += sheet.y;
+  return frame;
 }
\ No newline at end of file
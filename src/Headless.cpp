@@ -0,0 +1,165 @@
+#include "includes/Headless.hpp"
+#include "includes/World.hpp"
+#include "includes/Controller.hpp"
+#include "includes/JobSystem.hpp"
+#include "includes/InputLog.hpp"
+#include "includes/Profiler.hpp"
+#include <raylib.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+
+namespace
+{
+  // Deterministic stand-in for a player: walks and runs back and forth,
+  // jumps, shoots and punches on fixed beats so every run is the same
+  InputState ScriptedInput(long long tick)
+  {
+    InputState input = {};
+    long long phase = tick % 600;
+
+    input.right = phase < 240;
+    input.left = phase >= 300 && phase < 540;
+    input.run = (phase >= 120 && phase < 240) || (phase >= 420 && phase < 540);
+    input.jump = tick % 180 == 0;
+    input.primaryPressed = tick % 30 == 0;
+    input.secondaryPressed = tick % 97 == 0;
+    return input;
+  }
+}
+
+void TickTimings::Print(const char *label) const
+{
+  if (micros.empty())
+    return;
+
+  std::vector<float> sorted = micros;
+  std::sort(sorted.begin(), sorted.end());
+  auto percentile = [&](double p)
+  { return sorted[std::min(sorted.size() - 1, (size_t)(p * sorted.size()))]; };
+
+  double total = 0.0;
+  for (float us : micros)
+    total += us;
+
+  size_t worst = std::max_element(micros.begin(), micros.end()) - micros.begin();
+  printf("%s: %d ticks, %.2f us avg, p50 %.2f, p95 %.2f, p99 %.2f, worst %.2f us at tick %lld\n", label,
+         (int)micros.size(), total / micros.size(), percentile(0.5), percentile(0.95), percentile(0.99),
+         micros[worst], ticks[worst]);
+}
+
+bool TickTimings::Save(const std::string &path) const
+{
+  std::ofstream file(path);
+  if (!file)
+  {
+    TraceLog(LOG_WARNING, "TickTimings: can't write %s", path.c_str());
+    return false;
+  }
+
+  file << "tick,us\n";
+  for (size_t i = 0; i < micros.size(); i++)
+    file << ticks[i] << ',' << micros[i] << '\n';
+  return (bool)file;
+}
+
+int RunHeadless(const HeadlessConfig &baseConfig)
+{
+  using Clock = std::chrono::steady_clock;
+
+  SetTraceLogLevel(LOG_WARNING);
+
+  HeadlessConfig config = baseConfig;
+  if (config.replay != nullptr)
+  {
+    const InputLogHeader &header = config.replay->GetHeader();
+    config.worldWidth = header.worldWidth;
+    config.worldHeight = header.worldHeight;
+    config.botCount = header.botCount;
+    config.seed = header.seed;
+    config.ticks = config.replay->GetTickCount();
+  }
+
+  JobSystem jobs(config.threads);
+  World world;
+  world.Init(config.worldWidth, config.worldHeight, config.botCount, config.seed);
+  world.SetJobSystem(&jobs);
+
+  TickTimings timings;
+  timings.Reserve((size_t)config.ticks);
+  long long pairTests = 0, allPairs = 0, hits = 0;
+  long long thinking = 0, coasting = 0;
+  double fieldMs = 0.0, worstFieldMs = 0.0;
+  int fieldBuilds = 0;
+  Clock::time_point start = Clock::now();
+
+  for (long long tick = 0; tick < config.ticks; tick++)
+  {
+    // Recorded ticks spent in the menus never reached the world
+    if (config.replay != nullptr && !config.replay->StepsWorld((int)tick))
+      continue;
+
+    InputState input = config.replay != nullptr ? config.replay->GetInput((int)tick) : ScriptedInput(tick);
+
+    Clock::time_point tickStart = Clock::now();
+    world.Step(Controller::FixedStep, input);
+    timings.Add(tick, std::chrono::duration<double, std::micro>(Clock::now() - tickStart).count());
+    Profiler::EndFrame();
+
+    const CombatStats &combat = world.GetCombat().GetStats();
+    pairTests += combat.narrowTests;
+    allPairs += (long long)combat.projectiles * combat.bots;
+    hits += combat.hits;
+
+    const BotLodStats &lod = world.GetBots().GetLodStats();
+    thinking += lod.thinking;
+    coasting += lod.coasting;
+
+    const FlowField &field = world.GetFlowField();
+    if (field.GetRebuildCount() != fieldBuilds)
+    {
+      fieldBuilds = field.GetRebuildCount();
+      fieldMs += field.GetLastBuildMs();
+      worstFieldMs = std::max(worstFieldMs, (double)field.GetLastBuildMs());
+    }
+  }
+
+  double totalMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+  int alive = world.GetBots().GetAliveCount();
+
+  ProjectileStats projectiles = world.GetProjectiles().GetStats();
+
+  printf("headless: %lld ticks%s, world %.0fx%.0f, %d bots (%d alive), %d threads, seed %llu\n",
+         world.GetTick(), config.replay != nullptr ? " replayed" : "", config.worldWidth, config.worldHeight,
+         config.botCount, alive, jobs.GetThreadCount(), (unsigned long long)config.seed);
+  printf("headless: projectiles %d/%d in flight, high water %d, %lld fired, %lld dropped\n",
+         projectiles.active, projectiles.capacity, projectiles.highWater, projectiles.spawned, projectiles.overflows);
+  printf("headless: ai %lld decisions, %lld coasting bot ticks (%.1f%% thought)\n", thinking, coasting,
+         100.0 * thinking / std::max(thinking + coasting, 1LL));
+  printf("headless: flow field %d rebuilds, %.3f ms avg, %.3f ms worst\n", fieldBuilds,
+         fieldMs / std::max(fieldBuilds, 1), worstFieldMs);
+  printf("headless: combat %lld hits, %lld pair tests (all pairs would be %lld)\n", hits, pairTests, allPairs);
+  printf("headless: %.1f ms total, %.0f ticks/s (%.1fx realtime)\n", totalMs,
+         world.GetTick() / std::max(totalMs / 1000.0, 1e-9),
+         (world.GetTick() * Controller::FixedStep) / std::max(totalMs / 1000.0, 1e-9));
+  timings.Print("headless");
+  if (!config.timingsPath.empty())
+    timings.Save(config.timingsPath);
+
+  Profiler::PrintReport();
+  printf("headless: checksum %08x, %lld chunks stolen\n", world.GetChecksum(), jobs.GetStealCount());
+
+  // A diverged replay benchmarks a different workload than was recorded
+  bool diverged = false;
+  if (config.replay != nullptr && config.replay->GetHeader().hasChecksum)
+  {
+    uint32_t recorded = config.replay->GetHeader().checksum;
+    diverged = world.GetChecksum() != recorded;
+    printf("headless: replay %s the recorded checksum %08x\n", diverged ? "DIVERGED from" : "matches", recorded);
+  }
+
+  world.Unload();
+  return diverged ? 1 : 0;
+}
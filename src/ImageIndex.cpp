@@ -0,0 +1,76 @@
+#include "includes/ImageIndex.hpp"
+#include "includes/AssetArchive.hpp"
+#include <raylib.h>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+
+namespace
+{
+  std::unordered_map<std::string, ImageInfo> infos;
+
+  const uint8_t pngSignature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+
+  uint32_t ReadBigEndian(const uint8_t *bytes)
+  {
+    return (uint32_t)bytes[0] << 24 | (uint32_t)bytes[1] << 16 | (uint32_t)bytes[2] << 8 | (uint32_t)bytes[3];
+  }
+
+  // Signature, then the IHDR chunk: length, type, width, height
+  bool ReadPngHeader(const std::string &path, ImageInfo &info)
+  {
+    uint8_t header[24];
+    std::ifstream file(path, std::ios::binary);
+    if (!file.read(reinterpret_cast<char *>(header), sizeof(header)))
+      return false;
+
+    if (memcmp(header, pngSignature, sizeof(pngSignature)) != 0 || memcmp(header + 12, "IHDR", 4) != 0)
+      return false;
+
+    info.width = (int)ReadBigEndian(header + 16);
+    info.height = (int)ReadBigEndian(header + 20);
+    return true;
+  }
+
+  ImageInfo Lookup(const std::string &path)
+  {
+    ImageInfo info = {0, 0};
+    if (AssetArchive::GetSize(path, &info.width, &info.height) || ReadPngHeader(path, info))
+      return info;
+
+    Image image = LoadImage(path.c_str());
+    if (image.data != nullptr)
+    {
+      info = {image.width, image.height};
+      UnloadImage(image);
+    }
+    else
+    {
+      TraceLog(LOG_WARNING, "ImageIndex: can't read the size of %s", path.c_str());
+    }
+    return info;
+  }
+}
+
+ImageInfo ImageIndex::Get(const std::string &path)
+{
+  auto it = infos.find(path);
+  if (it != infos.end())
+    return it->second;
+
+  ImageInfo info = Lookup(path);
+  infos.emplace(path, info);
+  return info;
+}
+
+int ImageIndex::GetFrameCount(const std::string &path)
+{
+  ImageInfo info = Get(path);
+  return info.height > 0 ? info.width / info.height : 0;
+}
+
+void ImageIndex::Clear()
+{
+  infos.clear();
+}
@@ -0,0 +1,38 @@
+#include "includes/Input.hpp"
+
+InputState ReadInput()
+{
+  InputState input;
+  input.left = IsKeyDown(KEY_A) || IsKeyDown(KEY_LEFT);
+  input.right = IsKeyDown(KEY_D) || IsKeyDown(KEY_RIGHT);
+  input.run = IsKeyDown(KEY_SPACE);
+  input.jump = IsKeyDown(KEY_W) || IsKeyDown(KEY_UP);
+  input.fire = IsKeyDown(KEY_J);
+  input.melee = IsKeyDown(KEY_K);
+  input.mouse = GetMousePosition();
+  input.primaryPressed = IsMouseButtonPressed(MOUSE_BUTTON_LEFT);
+  input.primaryReleased = IsMouseButtonReleased(MOUSE_BUTTON_LEFT);
+  input.secondaryPressed = IsMouseButtonPressed(MOUSE_BUTTON_RIGHT);
+  return input;
+}
+
+void LatchInput(InputState &pending, const InputState &frame)
+{
+  pending.left = frame.left;
+  pending.right = frame.right;
+  pending.run = frame.run;
+  pending.jump = frame.jump;
+  pending.fire = frame.fire;
+  pending.melee = frame.melee;
+  pending.mouse = frame.mouse;
+  pending.primaryPressed = pending.primaryPressed || frame.primaryPressed;
+  pending.primaryReleased = pending.primaryReleased || frame.primaryReleased;
+  pending.secondaryPressed = pending.secondaryPressed || frame.secondaryPressed;
+}
+
+void ClearInputEdges(InputState &pending)
+{
+  pending.primaryPressed = false;
+  pending.primaryReleased = false;
+  pending.secondaryPressed = false;
+}
@@ -0,0 +1,177 @@
+#include "includes/InputLog.hpp"
+#include <raylib.h>
+#include <cmath>
+#include <fstream>
+
+// File layout, little endian:
+//   "MCIL" u32 version, u64 seed, f32 width, f32 height, i32 bots,
+//   u8 has checksum and u32 checksum (version 2 on), u32 runs
+//   then per run: u16 repeat count, u8 keys, u8 flags, i16 mouse x, i16 mouse y
+namespace
+{
+  const char magic[4] = {'M', 'C', 'I', 'L'};
+  const uint32_t version = 2;
+
+  enum KeyBits : uint8_t
+  {
+    LEFT = 1,
+    RIGHT = 2,
+    RUN = 4,
+    JUMP = 8,
+    FIRE = 16,
+    MELEE = 32,
+    PRIMARY_PRESSED = 64,
+    PRIMARY_RELEASED = 128
+  };
+
+  enum FlagBits : uint8_t
+  {
+    SECONDARY_PRESSED = 1,
+    WORLD_STEP = 2
+  };
+
+  template <typename T>
+  void Write(std::ofstream &file, const T &value)
+  {
+    file.write(reinterpret_cast<const char *>(&value), sizeof(T));
+  }
+
+  template <typename T>
+  bool Read(std::ifstream &file, T &value)
+  {
+    return (bool)file.read(reinterpret_cast<char *>(&value), sizeof(T));
+  }
+
+  int16_t PackCoord(float value)
+  {
+    return (int16_t)std::fmax(-32768.0f, std::fmin(32767.0f, std::round(value)));
+  }
+}
+
+void InputLog::Begin(const InputLogHeader &logHeader)
+{
+  header = logHeader;
+  ticks.clear();
+}
+
+void InputLog::Record(const InputState &input, bool worldStep)
+{
+  PackedTick tick;
+  tick.keys = (input.left ? LEFT : 0) | (input.right ? RIGHT : 0) | (input.run ? RUN : 0) |
+              (input.jump ? JUMP : 0) | (input.fire ? FIRE : 0) | (input.melee ? MELEE : 0) |
+              (input.primaryPressed ? PRIMARY_PRESSED : 0) | (input.primaryReleased ? PRIMARY_RELEASED : 0);
+  tick.flags = (input.secondaryPressed ? SECONDARY_PRESSED : 0) | (worldStep ? WORLD_STEP : 0);
+  tick.mouseX = PackCoord(input.mouse.x);
+  tick.mouseY = PackCoord(input.mouse.y);
+  ticks.push_back(tick);
+}
+
+InputState InputLog::GetInput(int index) const
+{
+  const PackedTick &tick = ticks[index];
+  InputState input;
+  input.left = tick.keys & LEFT;
+  input.right = tick.keys & RIGHT;
+  input.run = tick.keys & RUN;
+  input.jump = tick.keys & JUMP;
+  input.fire = tick.keys & FIRE;
+  input.melee = tick.keys & MELEE;
+  input.mouse = {(float)tick.mouseX, (float)tick.mouseY};
+  input.primaryPressed = tick.keys & PRIMARY_PRESSED;
+  input.primaryReleased = tick.keys & PRIMARY_RELEASED;
+  input.secondaryPressed = tick.flags & SECONDARY_PRESSED;
+  return input;
+}
+
+bool InputLog::StepsWorld(int index) const
+{
+  return (ticks[index].flags & WORLD_STEP) != 0;
+}
+
+bool InputLog::Save(const std::string &path) const
+{
+  std::ofstream file(path, std::ios::binary);
+  if (!file)
+  {
+    TraceLog(LOG_WARNING, "InputLog: can't write %s", path.c_str());
+    return false;
+  }
+
+  // Runs of identical ticks, a held key or an idle mouse is one entry
+  std::vector<std::pair<uint16_t, PackedTick>> runs;
+  for (const PackedTick &tick : ticks)
+  {
+    if (!runs.empty() && runs.back().second == tick && runs.back().first < UINT16_MAX)
+      runs.back().first++;
+    else
+      runs.push_back({1, tick});
+  }
+
+  file.write(magic, sizeof(magic));
+  Write(file, version);
+  Write(file, header.seed);
+  Write(file, header.worldWidth);
+  Write(file, header.worldHeight);
+  Write(file, (int32_t)header.botCount);
+  Write(file, (uint8_t)(header.hasChecksum ? 1 : 0));
+  Write(file, header.checksum);
+  Write(file, (uint32_t)runs.size());
+
+  for (const auto &run : runs)
+  {
+    Write(file, run.first);
+    Write(file, run.second.keys);
+    Write(file, run.second.flags);
+    Write(file, run.second.mouseX);
+    Write(file, run.second.mouseY);
+  }
+
+  TraceLog(LOG_INFO, "InputLog: saved %d ticks as %d runs to %s", GetTickCount(), (int)runs.size(), path.c_str());
+  return (bool)file;
+}
+
+bool InputLog::Load(const std::string &path)
+{
+  ticks.clear();
+
+  std::ifstream file(path, std::ios::binary);
+  char fileMagic[4] = {};
+  uint32_t fileVersion = 0;
+  if (!file || !file.read(fileMagic, sizeof(fileMagic)) || !Read(file, fileVersion) ||
+      std::string(fileMagic, 4) != std::string(magic, 4) || fileVersion < 1 || fileVersion > version)
+  {
+    TraceLog(LOG_WARNING, "InputLog: %s is not an input log", path.c_str());
+    return false;
+  }
+
+  int32_t botCount = 0;
+  uint32_t runCount = 0;
+  uint8_t hasChecksum = 0;
+  header.checksum = 0;
+  if (!Read(file, header.seed) || !Read(file, header.worldWidth) || !Read(file, header.worldHeight) ||
+      !Read(file, botCount) || (fileVersion >= 2 && (!Read(file, hasChecksum) || !Read(file, header.checksum))) ||
+      !Read(file, runCount))
+  {
+    TraceLog(LOG_WARNING, "InputLog: %s has a truncated header", path.c_str());
+    return false;
+  }
+  header.botCount = botCount;
+  header.hasChecksum = hasChecksum != 0;
+
+  for (uint32_t i = 0; i < runCount; i++)
+  {
+    uint16_t repeat = 0;
+    PackedTick tick;
+    if (!Read(file, repeat) || !Read(file, tick.keys) || !Read(file, tick.flags) ||
+        !Read(file, tick.mouseX) || !Read(file, tick.mouseY))
+    {
+      TraceLog(LOG_WARNING, "InputLog: %s is truncated after %d ticks", path.c_str(), GetTickCount());
+      return false;
+    }
+    ticks.insert(ticks.end(), repeat, tick);
+  }
+
+  TraceLog(LOG_INFO, "InputLog: loaded %d ticks from %s, seed %llu", GetTickCount(), path.c_str(),
+           (unsigned long long)header.seed);
+  return true;
+}
@@ -0,0 +1,174 @@
+#include "includes/JobSystem.hpp"
+#include <algorithm>
+
+namespace
+{
+  // Which pool and queue the current thread works for
+  thread_local const JobSystem *currentSystem = nullptr;
+  thread_local int currentQueue = 0;
+}
+
+JobSystem::JobSystem(int threadCount)
+    : queued(0),
+      steals(0),
+      stopping(false)
+{
+  if (threadCount <= 0)
+    threadCount = std::max(1, (int)std::thread::hardware_concurrency());
+
+  for (int i = 0; i < threadCount; i++)
+    queues.push_back(std::make_unique<Queue>());
+
+  // Queue 0 belongs to whoever calls in, the rest get a worker each
+  for (int i = 1; i < threadCount; i++)
+    workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+}
+
+JobSystem::~JobSystem()
+{
+  {
+    std::lock_guard<std::mutex> lock(sleepMutex);
+    stopping = true;
+  }
+  wake.notify_all();
+
+  for (std::thread &worker : workers)
+    worker.join();
+}
+
+int JobSystem::CurrentQueue() const
+{
+  return currentSystem == this ? currentQueue : 0;
+}
+
+void JobSystem::Run(Job job, JobCounter *counter)
+{
+  if (counter != nullptr)
+    counter->fetch_add(1);
+
+  if (workers.empty())
+  {
+    job();
+    if (counter != nullptr)
+      counter->fetch_sub(1);
+    return;
+  }
+
+  Queue &queue = *queues[CurrentQueue()];
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.jobs.push_back({std::move(job), counter});
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(sleepMutex);
+    queued.fetch_add(1);
+  }
+  wake.notify_one();
+}
+
+bool JobSystem::TryRunOne(int queueIndex)
+{
+  QueuedJob next = {nullptr, nullptr};
+  int count = (int)queues.size();
+
+  // Own queue newest first (still warm in cache), then steal the oldest job
+  // of the other queues
+  for (int i = 0; i < count && !next.job; i++)
+  {
+    Queue &queue = *queues[(queueIndex + i) % count];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.jobs.empty())
+      continue;
+
+    if (i == 0)
+    {
+      next = std::move(queue.jobs.back());
+      queue.jobs.pop_back();
+    }
+    else
+    {
+      next = std::move(queue.jobs.front());
+      queue.jobs.pop_front();
+      steals.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  if (!next.job)
+    return false;
+
+  queued.fetch_sub(1);
+  next.job();
+  if (next.counter != nullptr)
+    next.counter->fetch_sub(1, std::memory_order_release);
+  return true;
+}
+
+void JobSystem::WorkerLoop(int queueIndex)
+{
+  currentSystem = this;
+  currentQueue = queueIndex;
+
+  while (true)
+  {
+    if (TryRunOne(queueIndex))
+      continue;
+
+    std::unique_lock<std::mutex> lock(sleepMutex);
+    wake.wait(lock, [this]
+              { return stopping || queued.load() > 0; });
+    if (stopping)
+      return;
+  }
+}
+
+void JobSystem::Wait(JobCounter &counter)
+{
+  int queueIndex = CurrentQueue();
+
+  // Help with any job while waiting, ours are likely among them
+  while (counter.load(std::memory_order_acquire) > 0)
+  {
+    if (!TryRunOne(queueIndex))
+      std::this_thread::yield();
+  }
+}
+
+void JobSystem::ParallelFor(int count, int chunkSize, const std::function<void(int begin, int end)> &body)
+{
+  chunkSize = std::max(1, chunkSize);
+
+  if (workers.empty() || count <= chunkSize)
+  {
+    if (count > 0)
+      body(0, count);
+    return;
+  }
+
+  // Deal the chunks out over all queues so every thread starts right away,
+  // stealing evens out chunks that take longer
+  JobCounter counter(0);
+  int queueCount = (int)queues.size();
+  int chunk = 0;
+
+  for (int begin = 0; begin < count; begin += chunkSize, chunk++)
+  {
+    int end = std::min(begin + chunkSize, count);
+    Queue &queue = *queues[chunk % queueCount];
+
+    counter.fetch_add(1);
+    {
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      queue.jobs.push_back({[&body, begin, end]
+                            { body(begin, end); },
+                            &counter});
+    }
+    {
+      std::lock_guard<std::mutex> lock(sleepMutex);
+      queued.fetch_add(1);
+    }
+  }
+
+  wake.notify_all();
+  Wait(counter);
+}
@@ -0,0 +1,179 @@
+#include "includes/LayerStrip.hpp"
+#include "includes/Profiler.hpp"
+#include "includes/Layer.hpp"
+#include "includes/GameLayer.hpp"
+#include <rlgl.h>
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+  // Scale of the strip is relative to the source art, textures may have
+  // been loaded smaller than that
+  float GetDrawScale(const TextureHandle &texture, float scale)
+  {
+    return scale / texture.GetScale();
+  }
+}
+
+LayerStrip::LayerStrip(float parallaxFactor, float layerScale)
+    : target{},
+      parallax(parallaxFactor),
+      scale(layerScale),
+      width(0.0f),
+      scrollX(0.0f),
+      prevScrollX(0.0f),
+      dirty(true)
+{
+}
+
+LayerStrip::~LayerStrip()
+{
+  if (target.id != 0)
+    UnloadRenderTexture(target);
+}
+
+// yOffset is in source art pixels and scales with the strip
+void LayerStrip::AddLayer(const TextureHandle &texture, float yOffset)
+{
+  layers.push_back({texture, yOffset});
+  dirty = true;
+}
+
+void LayerStrip::ClearLayers()
+{
+  layers.clear();
+  dirty = true;
+}
+
+void LayerStrip::SetScale(float newScale)
+{
+  if (newScale != scale)
+  {
+    scale = newScale;
+    dirty = true;
+  }
+}
+
+void LayerStrip::Update(float distance)
+{
+  prevScrollX = scrollX;
+  scrollX -= distance * parallax;
+
+  // Wrap for seamless repeat, shifting the previous value by the same amount
+  // so interpolation doesn't sweep back across the whole strip
+  if (width > 0.0f)
+  {
+    float wrapped = fmodf(scrollX, width);
+    prevScrollX += wrapped - scrollX;
+    scrollX = wrapped;
+  }
+}
+
+void LayerStrip::Bake()
+{
+  dirty = false;
+
+  width = 0.0f;
+  float height = 0.0f;
+  for (const StripLayer &layer : layers)
+  {
+    float drawScale = GetDrawScale(layer.texture, scale);
+    width = std::max(width, layer.texture.GetWidth() * drawScale);
+    height = std::max(height, layer.yOffset * scale + layer.texture.GetHeight() * drawScale);
+  }
+
+  if (target.id != 0)
+    UnloadRenderTexture(target);
+  target = {};
+
+  if (width <= 0.0f || height <= 0.0f)
+    return;
+
+  target = LoadRenderTexture((int)width, (int)height);
+  SetTextureWrap(target.texture, TEXTURE_WRAP_REPEAT);
+
+  // Composite into transparent pixels with premultiplied alpha so partly
+  // transparent edges keep their coverage when the strip is drawn
+  BeginTextureMode(target);
+  ClearBackground(BLANK);
+  rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA, RL_FUNC_ADD, RL_FUNC_ADD);
+  BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+
+  for (const StripLayer &layer : layers)
+    DrawTextureEx(layer.texture.Get(), {0.0f, layer.yOffset * scale}, 0.0f, GetDrawScale(layer.texture, scale), WHITE);
+
+  EndBlendMode();
+  EndTextureMode();
+
+  TraceLog(LOG_INFO, "LayerStrip: baked %d layers into %dx%d", (int)layers.size(), (int)width, (int)height);
+}
+
+void LayerStrip::Draw(float alpha)
+{
+  PROFILE_ZONE("LayerStrip::Draw");
+  if (dirty)
+    Bake();
+
+  if (target.id == 0)
+    return;
+
+  // One quad across the screen, the repeat wrap mode tiles the strip.
+  // Render textures are stored upside down, hence the negative height
+  float screenWidth = (float)GetScreenWidth();
+  float height = (float)target.texture.height;
+  float drawScroll = prevScrollX + (scrollX - prevScrollX) * alpha;
+  Rectangle source = {-drawScroll, 0.0f, screenWidth, -height};
+  Rectangle dest = {0.0f, 0.0f, screenWidth, height};
+
+  BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+  DrawTexturePro(target.texture, source, dest, {0, 0}, 0.0f, WHITE);
+  EndBlendMode();
+}
+
+std::vector<LayerStrip *> LayerStrip::Build(const std::vector<Gamelayer *> &source)
+{
+  std::vector<LayerStrip *> strips;
+
+  for (const Gamelayer *layer : source)
+  {
+    LayerStrip *last = strips.empty() ? nullptr : strips.back();
+    float layerWidth = layer->GetTexture().GetWidth() * layer->GetDrawScale();
+    const TextureHandle *first = last != nullptr ? &last->layers.front().texture : nullptr;
+
+    if (last == nullptr || last->parallax != layer->GetParallax() || last->scale != layer->GetScale() ||
+        first->GetWidth() * GetDrawScale(*first, last->scale) != layerWidth)
+    {
+      last = new LayerStrip(layer->GetParallax(), layer->GetScale());
+      strips.push_back(last);
+    }
+
+    // Gamelayer offsets are already in screen pixels
+    last->AddLayer(layer->GetTexture(), layer->GetYOffset() / layer->GetScale());
+  }
+
+  return strips;
+}
+
+std::vector<LayerStrip *> LayerStrip::Build(const std::vector<Layer *> &source)
+{
+  std::vector<LayerStrip *> strips;
+
+  for (const Layer *layer : source)
+  {
+    LayerStrip *last = strips.empty() ? nullptr : strips.back();
+    float layerWidth = layer->GetTexture().GetWidth() * layer->GetDrawScale();
+    const TextureHandle *first = last != nullptr ? &last->layers.front().texture : nullptr;
+
+    if (last == nullptr || last->parallax != layer->GetSpeed() || last->scale != layer->GetScale() ||
+        first->GetWidth() * GetDrawScale(*first, last->scale) != layerWidth)
+    {
+      last = new LayerStrip(layer->GetSpeed(), layer->GetScale());
+      strips.push_back(last);
+    }
+
+    last->AddLayer(layer->GetTexture(), layer->GetYOffset());
+  }
+
+  return strips;
+}
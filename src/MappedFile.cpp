@@ -0,0 +1,133 @@
+#include "includes/MappedFile.hpp"
+#include <fstream>
+
+// No raylib in this file: windows.h declares names that clash with it
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+  const size_t pageSize = 4096;
+}
+
+MappedFile::MappedFile()
+    : data(nullptr),
+      size(0),
+      fileHandle(nullptr),
+      mappingHandle(nullptr)
+{
+}
+
+MappedFile::~MappedFile()
+{
+  Close();
+}
+
+bool MappedFile::Open(const std::string &path)
+{
+  Close();
+
+#if defined(_WIN32)
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    return false;
+
+  LARGE_INTEGER fileSize;
+  HANDLE mapping = nullptr;
+  if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+    mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+  void *view = mapping != nullptr ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+  if (view != nullptr)
+  {
+    data = static_cast<const uint8_t *>(view);
+    size = (size_t)fileSize.QuadPart;
+    fileHandle = file;
+    mappingHandle = mapping;
+    return true;
+  }
+
+  if (mapping != nullptr)
+    CloseHandle(mapping);
+  CloseHandle(file);
+#else
+  int file = open(path.c_str(), O_RDONLY);
+  if (file < 0)
+    return false;
+
+  struct stat info;
+  void *view = MAP_FAILED;
+  if (fstat(file, &info) == 0 && info.st_size > 0)
+    view = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+  close(file); // The mapping keeps its own reference
+
+  if (view != MAP_FAILED)
+  {
+    data = static_cast<const uint8_t *>(view);
+    size = (size_t)info.st_size;
+    return true;
+  }
+#endif
+
+  // No mapping on this platform or filesystem, read it all instead
+  std::ifstream in(path, std::ios::binary | std::ios::ate);
+  if (!in)
+    return false;
+
+  std::streamsize length = in.tellg();
+  if (length <= 0)
+    return false;
+
+  buffer.resize((size_t)length);
+  in.seekg(0);
+  if (!in.read(reinterpret_cast<char *>(buffer.data()), length))
+  {
+    buffer.clear();
+    return false;
+  }
+
+  data = buffer.data();
+  size = buffer.size();
+  return true;
+}
+
+void MappedFile::Close()
+{
+  if (IsMapped())
+  {
+#if defined(_WIN32)
+    UnmapViewOfFile(data);
+    CloseHandle(mappingHandle);
+    CloseHandle(fileHandle);
+#else
+    munmap(const_cast<uint8_t *>(data), size);
+#endif
+  }
+
+  buffer.clear();
+  buffer.shrink_to_fit();
+  data = nullptr;
+  size = 0;
+  fileHandle = nullptr;
+  mappingHandle = nullptr;
+}
+
+void MappedFile::Prefault(const void *start, size_t length)
+{
+  const volatile uint8_t *bytes = static_cast<const volatile uint8_t *>(start);
+  uint8_t sink = 0;
+  for (size_t offset = 0; offset < length; offset += pageSize)
+    sink ^= bytes[offset];
+  if (length > 0)
+    sink ^= bytes[length - 1];
+  (void)sink;
+}
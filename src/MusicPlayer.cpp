@@ -0,0 +1,170 @@
+#include "includes/MusicPlayer.hpp"
+#include "includes/Profiler.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace
+{
+  // Well under the length of one stream buffer, so refills are never late
+  const auto refillInterval = std::chrono::milliseconds(5);
+}
+
+MusicPlayer::MusicPlayer()
+    : running(false)
+{
+}
+
+MusicPlayer::~MusicPlayer()
+{
+  Unload();
+}
+
+int MusicPlayer::Load(const std::string &path)
+{
+  if (running.load())
+  {
+    TraceLog(LOG_WARNING, "MusicPlayer: %s loaded after Start, ignored", path.c_str());
+    return -1;
+  }
+
+  Music music = LoadMusicStream(path.c_str());
+  if (music.stream.buffer == nullptr)
+    return -1;
+
+  tracks.push_back({music, false, 1.0f, 1.0f, 0.0f});
+  return (int)tracks.size() - 1;
+}
+
+void MusicPlayer::Start()
+{
+  if (running.exchange(true))
+    return;
+
+  thread = std::thread(&MusicPlayer::ThreadLoop, this);
+}
+
+void MusicPlayer::Unload()
+{
+  running.store(false);
+  if (thread.joinable())
+    thread.join();
+
+  for (Track &track : tracks)
+    UnloadMusicStream(track.music);
+  tracks.clear();
+}
+
+void MusicPlayer::Play(int track)
+{
+  Send({CommandType::PLAY, track, 0.0f, 0.0f});
+}
+
+void MusicPlayer::Stop(int track)
+{
+  Send({CommandType::STOP, track, 0.0f, 0.0f});
+}
+
+void MusicPlayer::SetVolume(int track, float volume)
+{
+  Send({CommandType::VOLUME, track, volume, 0.0f});
+}
+
+void MusicPlayer::Fade(int track, float targetVolume, float seconds)
+{
+  Send({CommandType::FADE, track, targetVolume, seconds});
+}
+
+void MusicPlayer::Send(const Command &command)
+{
+  if (command.track < 0 || command.track >= (int)tracks.size())
+    return;
+
+  // Before Start there is no thread to race with
+  if (!running.load(std::memory_order_relaxed))
+  {
+    Apply(command);
+    return;
+  }
+
+  if (!commands.Push(command))
+    TraceLog(LOG_WARNING, "MusicPlayer: command queue full, command dropped");
+}
+
+// Audio thread, or the main thread before Start
+void MusicPlayer::Apply(const Command &command)
+{
+  Track &track = tracks[command.track];
+
+  switch (command.type)
+  {
+  case CommandType::PLAY:
+    PlayMusicStream(track.music);
+    track.playing = true;
+    break;
+  case CommandType::STOP:
+    StopMusicStream(track.music);
+    track.playing = false;
+    track.fadeRate = 0.0f;
+    break;
+  case CommandType::VOLUME:
+    track.volume = std::clamp(command.volume, 0.0f, 1.0f);
+    track.fadeRate = 0.0f;
+    SetMusicVolume(track.music, track.volume);
+    break;
+  case CommandType::FADE:
+    track.fadeTarget = std::clamp(command.volume, 0.0f, 1.0f);
+    if (command.seconds > 0.0f)
+    {
+      track.fadeRate = std::fabs(track.fadeTarget - track.volume) / command.seconds;
+    }
+    else
+    {
+      track.volume = track.fadeTarget;
+      track.fadeRate = 0.0f;
+      SetMusicVolume(track.music, track.volume);
+    }
+    break;
+  }
+}
+
+void MusicPlayer::ThreadLoop()
+{
+  using Clock = std::chrono::steady_clock;
+  Clock::time_point last = Clock::now();
+
+  while (running.load(std::memory_order_relaxed))
+  {
+    std::this_thread::sleep_for(refillInterval);
+    PROFILE_ZONE("MusicPlayer::Refill");
+
+    Command command;
+    while (commands.Pop(command))
+      Apply(command);
+
+    Clock::time_point now = Clock::now();
+    float elapsed = std::chrono::duration<float>(now - last).count();
+    last = now;
+
+    for (Track &track : tracks)
+    {
+      if (track.fadeRate > 0.0f)
+      {
+        float step = track.fadeRate * elapsed;
+        if (std::fabs(track.fadeTarget - track.volume) <= step)
+        {
+          track.volume = track.fadeTarget;
+          track.fadeRate = 0.0f;
+        }
+        else
+        {
+          track.volume += track.fadeTarget > track.volume ? step : -step;
+        }
+        SetMusicVolume(track.music, track.volume);
+      }
+
+      if (track.playing)
+        UpdateMusicStream(track.music);
+    }
+  }
+}
@@ -0,0 +1,297 @@
+#include "includes/Profiler.hpp"
+#include <raylib.h>
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+  const int historyFrames = 240;         // Frames the averages and p99 cover
+  const size_t maxTraceEvents = 1 << 20; // Stop a capture early rather than run out of memory
+
+  struct Event
+  {
+    const char *name;
+    const char *parent;
+    int64_t start, end;
+  };
+
+  // One per thread that ever opened a zone. Only the owner appends, EndFrame
+  // takes the events under the lock
+  struct ThreadBuffer
+  {
+    std::mutex mutex;
+    std::vector<Event> events;
+    const char *current = nullptr; // Innermost open zone
+    int id = 0;
+  };
+
+  struct ZoneStats
+  {
+    const char *name;
+    const char *parent;
+    float history[historyFrames]; // Milliseconds per frame, summed over threads
+    float frameMs;
+    int frameCalls, lastCalls;
+  };
+
+  struct TraceEvent
+  {
+    Event event;
+    int thread;
+  };
+
+  std::mutex registryMutex;
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers; // Kept until exit so threads may end any time
+  thread_local ThreadBuffer *localBuffer = nullptr;
+
+  // A zone is a name under one parent: the same code run by a worker and by
+  // a thread waiting on it shows up twice, in the place each one ran it
+  struct ZoneKey
+  {
+    const char *name;
+    const char *parent;
+
+    bool operator==(const ZoneKey &other) const { return name == other.name && parent == other.parent; }
+  };
+
+  struct ZoneKeyHash
+  {
+    size_t operator()(const ZoneKey &key) const
+    {
+      return std::hash<const char *>()(key.name) * 31u + std::hash<const char *>()(key.parent);
+    }
+  };
+
+  std::vector<ZoneStats> zones;
+  std::unordered_map<ZoneKey, int, ZoneKeyHash> zoneIndex;
+  std::vector<Event> frameEvents;
+  long long frameCount = 0;
+  bool overlayVisible = false;
+
+  std::string tracePath;
+  int traceFramesLeft = 0;
+  std::vector<TraceEvent> trace;
+
+  ThreadBuffer &LocalBuffer()
+  {
+    if (localBuffer == nullptr)
+    {
+      std::lock_guard<std::mutex> lock(registryMutex);
+      buffers.push_back(std::make_unique<ThreadBuffer>());
+      localBuffer = buffers.back().get();
+      localBuffer->id = (int)buffers.size() - 1;
+    }
+    return *localBuffer;
+  }
+
+  ZoneStats &FindZone(const Event &event)
+  {
+    ZoneKey key = {event.name, event.parent};
+    auto found = zoneIndex.find(key);
+    if (found != zoneIndex.end())
+      return zones[found->second];
+
+    zoneIndex[key] = (int)zones.size();
+    zones.push_back({event.name, event.parent, {}, 0.0f, 0, 0});
+    return zones.back();
+  }
+
+  void Summarize(const ZoneStats &zone, float &average, float &p99)
+  {
+    int count = (int)std::min<long long>(frameCount, historyFrames);
+    if (count == 0)
+    {
+      average = p99 = 0.0f;
+      return;
+    }
+
+    float sorted[historyFrames];
+    float total = 0.0f;
+    for (int i = 0; i < count; i++)
+    {
+      sorted[i] = zone.history[i];
+      total += zone.history[i];
+    }
+    std::sort(sorted, sorted + count);
+    average = total / count;
+    p99 = sorted[std::min(count - 1, (int)(count * 0.99f))];
+  }
+
+  // Depth first from the root zones, in the order they were first seen
+  template <typename Visitor>
+  void VisitTree(const char *parent, int depth, Visitor &&visit)
+  {
+    for (const ZoneStats &zone : zones)
+    {
+      if (zone.parent != parent)
+        continue;
+      visit(zone, depth);
+      VisitTree(zone.name, depth + 1, visit);
+    }
+  }
+
+  void WriteTrace()
+  {
+    FILE *file = fopen(tracePath.c_str(), "w");
+    if (file == nullptr)
+    {
+      TraceLog(LOG_WARNING, "Profiler: can't write %s", tracePath.c_str());
+      return;
+    }
+
+    int64_t origin = trace.empty() ? 0 : trace.front().event.start;
+    for (const TraceEvent &entry : trace)
+      origin = std::min(origin, entry.event.start);
+
+    fprintf(file, "{\"traceEvents\":[\n");
+    for (size_t i = 0; i < trace.size(); i++)
+    {
+      const Event &event = trace[i].event;
+      fprintf(file, "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}%s\n",
+              event.name, trace[i].thread, (event.start - origin) / 1000.0, (event.end - event.start) / 1000.0,
+              i + 1 < trace.size() ? "," : "");
+    }
+    fprintf(file, "]}\n");
+    fclose(file);
+
+    TraceLog(LOG_INFO, "Profiler: wrote %d events to %s", (int)trace.size(), tracePath.c_str());
+    trace.clear();
+    trace.shrink_to_fit();
+  }
+}
+
+ProfileZone::ProfileZone(const char *zoneName)
+    : name(zoneName)
+{
+  ThreadBuffer &buffer = LocalBuffer();
+  parent = buffer.current;
+  buffer.current = name;
+  start = Profiler::Now();
+}
+
+ProfileZone::~ProfileZone()
+{
+  int64_t end = Profiler::Now();
+  ThreadBuffer &buffer = *localBuffer;
+  buffer.current = parent;
+
+  std::lock_guard<std::mutex> lock(buffer.mutex);
+  buffer.events.push_back({name, parent, start, end});
+}
+
+int64_t Profiler::Now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void Profiler::EndFrame()
+{
+  std::vector<ThreadBuffer *> threads;
+  {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (const std::unique_ptr<ThreadBuffer> &buffer : buffers)
+      threads.push_back(buffer.get());
+  }
+
+  for (ThreadBuffer *buffer : threads)
+  {
+    {
+      std::lock_guard<std::mutex> lock(buffer->mutex);
+      frameEvents.swap(buffer->events);
+    }
+
+    for (const Event &event : frameEvents)
+    {
+      ZoneStats &zone = FindZone(event);
+      zone.frameMs += (event.end - event.start) / 1e6f;
+      zone.frameCalls++;
+
+      if (traceFramesLeft > 0 && trace.size() < maxTraceEvents)
+        trace.push_back({event, buffer->id});
+    }
+    frameEvents.clear();
+  }
+
+  int slot = (int)(frameCount % historyFrames);
+  for (ZoneStats &zone : zones)
+  {
+    zone.history[slot] = zone.frameMs;
+    zone.lastCalls = zone.frameCalls;
+    zone.frameMs = 0.0f;
+    zone.frameCalls = 0;
+  }
+  frameCount++;
+
+  if (traceFramesLeft > 0 && --traceFramesLeft == 0)
+    WriteTrace();
+}
+
+void Profiler::ToggleOverlay()
+{
+  overlayVisible = !overlayVisible;
+}
+
+bool Profiler::IsOverlayVisible()
+{
+  return overlayVisible;
+}
+
+void Profiler::DrawOverlay(int x, int y)
+{
+  if (!overlayVisible)
+    return;
+
+  const int fontSize = 10;
+  const int lineHeight = 12;
+  int lines = (int)zones.size() + 1;
+  DrawRectangle(x, y, 330, lines * lineHeight + 8, Fade(BLACK, 0.7f));
+
+  int lineY = y + 4;
+  DrawText(IsEnabled() ? "zone                        avg ms   p99 ms  calls" : "profiler compiled out",
+           x + 4, lineY, fontSize, YELLOW);
+
+  VisitTree(nullptr, 0, [&](const ZoneStats &zone, int depth)
+            {
+              float average, p99;
+              Summarize(zone, average, p99);
+              lineY += lineHeight;
+              DrawText(zone.name, x + 4 + depth * 8, lineY, fontSize, RAYWHITE);
+              DrawText(TextFormat("%7.3f  %7.3f  %5d", average, p99, zone.lastCalls), x + 190, lineY, fontSize, RAYWHITE); });
+}
+
+void Profiler::CaptureTrace(const std::string &path, int frames)
+{
+  if (!IsEnabled() || traceFramesLeft > 0)
+    return;
+
+  tracePath = path;
+  traceFramesLeft = std::max(frames, 1);
+  trace.clear();
+  TraceLog(LOG_INFO, "Profiler: capturing %d frames to %s", traceFramesLeft, path.c_str());
+}
+
+void Profiler::PrintReport()
+{
+  if (zones.empty())
+    return;
+
+  printf("%-34s %9s %9s %7s\n", "profile: zone", "avg ms", "p99 ms", "calls");
+  VisitTree(nullptr, 0, [](const ZoneStats &zone, int depth)
+            {
+              float average, p99;
+              Summarize(zone, average, p99);
+              printf("  %*s%-*s %9.3f %9.3f %7d\n", depth * 2, "", 32 - depth * 2, zone.name, average, p99, zone.lastCalls); });
+}
+
+bool Profiler::IsEnabled()
+{
+#ifdef ENABLE_PROFILER
+  return true;
+#else
+  return false;
+#endif
+}
@@ -0,0 +1,177 @@
+#include "includes/ProjectilePool.hpp"
+#include "includes/ImageIndex.hpp"
+#include <algorithm>
+
+// Indexed by ProjectileType
+const ProjectileArchetype ProjectilePool::archetypes[ProjectileTypeCount] = {
+    // Bullet - 3 frame sheet
+    {"resource/player/bullet.png", 3, 0.1f, 480.0f, 20}};
+
+Vector2 ProjectilePool::frameSizes[ProjectileTypeCount];
+
+SpriteRegion ProjectilePool::sprites[ProjectileTypeCount];
+
+ProjectilePool::ProjectilePool(int capacity)
+    : capacity(capacity),
+      count(0),
+      posX(capacity),
+      posY(capacity),
+      prevX(capacity),
+      velocityX(capacity),
+      frameTimer(capacity),
+      frame(capacity),
+      types(capacity),
+      highWater(0),
+      spawned(0),
+      overflows(0)
+{
+  LoadFrameSizes();
+}
+
+// From the image header, so hit sizes follow the art and headless runs,
+// which load no sprites, get the same ones
+void ProjectilePool::LoadFrameSizes()
+{
+  for (int type = 0; type < ProjectileTypeCount; type++)
+  {
+    if (frameSizes[type].x > 0.0f)
+      continue;
+    const ProjectileArchetype &archetype = archetypes[type];
+    ImageInfo info = ImageIndex::Get(archetype.sheetPath);
+    if (info.width <= 0 || info.height <= 0)
+    {
+      TraceLog(LOG_WARNING, "ProjectilePool: can't read the size of %s", archetype.sheetPath);
+      info = {archetype.frameCount, 1};
+    }
+    frameSizes[type] = {(float)info.width / archetype.frameCount, (float)info.height};
+  }
+}
+
+void ProjectilePool::LoadSprites()
+{
+  for (int type = 0; type < ProjectileTypeCount; type++)
+  {
+    sprites[type] = SpriteAtlas::Acquire(archetypes[type].sheetPath);
+    if (!sprites[type].IsValid())
+      TraceLog(LOG_ERROR, "failed to load projectile texture %s", archetypes[type].sheetPath);
+  }
+}
+
+void ProjectilePool::UnloadSprites()
+{
+  for (SpriteRegion &sprite : sprites)
+    sprite = SpriteRegion();
+}
+
+bool ProjectilePool::Spawn(ProjectileType type, Vector2 position, int direction)
+{
+  if (count == capacity)
+  {
+    if (overflows++ == 0)
+      TraceLog(LOG_WARNING, "ProjectilePool: full at %d, dropping new projectiles", capacity);
+    return false;
+  }
+
+  int i = count++;
+  posX[i] = position.x;
+  posY[i] = position.y;
+  prevX[i] = position.x;
+  velocityX[i] = archetypes[(int)type].speed * direction;
+  frameTimer[i] = 0.0f;
+  frame[i] = 0;
+  types[i] = type;
+
+  spawned++;
+  highWater = std::max(highWater, count);
+  return true;
+}
+
+// Order isn't kept, the last projectile takes the freed slot
+void ProjectilePool::Despawn(int index)
+{
+  int last = --count;
+  posX[index] = posX[last];
+  posY[index] = posY[last];
+  prevX[index] = prevX[last];
+  velocityX[index] = velocityX[last];
+  frameTimer[index] = frameTimer[last];
+  frame[index] = frame[last];
+  types[index] = types[last];
+}
+
+void ProjectilePool::Clear()
+{
+  count = 0;
+  highWater = 0;
+  spawned = 0;
+  overflows = 0;
+}
+
+void ProjectilePool::Update(float deltaTime, float worldWidth)
+{
+  // Move, the arrays are contiguous so this loop vectorizes
+  for (int i = 0; i < count; i++)
+  {
+    prevX[i] = posX[i];
+    posX[i] += velocityX[i] * deltaTime;
+  }
+
+  // Animate, advancing one frame whenever the timer runs out
+  for (int i = 0; i < count; i++)
+  {
+    const ProjectileArchetype &archetype = archetypes[(int)types[i]];
+    frameTimer[i] += deltaTime;
+    if (frameTimer[i] >= archetype.frameTime)
+    {
+      frameTimer[i] = 0.0f;
+      frame[i] = (uint8_t)((frame[i] + 1) % archetype.frameCount);
+    }
+  }
+
+  // Drop projectiles that left the world, walking backwards so the one
+  // swapped into a freed slot has already been checked
+  for (int i = count - 1; i >= 0; i--)
+  {
+    float width = frameSizes[(int)types[i]].x;
+    if (posX[i] < -width || posX[i] > worldWidth + width)
+      Despawn(i);
+  }
+}
+
+Rectangle ProjectilePool::GetBounds(int index) const
+{
+  Vector2 size = frameSizes[(int)types[index]];
+  return {posX[index], posY[index], size.x, size.y};
+}
+
+void ProjectilePool::Draw(RenderQueue &queue, float alpha) const
+{
+  for (int i = 0; i < count; i++)
+  {
+    const ProjectileArchetype &archetype = archetypes[(int)types[i]];
+    const SpriteRegion &sheet = sprites[(int)types[i]];
+
+    float frameWidth = sheet.source.width / archetype.frameCount;
+    Rectangle source = {sheet.source.x + frame[i] * frameWidth, sheet.source.y, frameWidth, sheet.source.height};
+
+    // Flip horizontally - negative width mirrors the same frame in place
+    if (velocityX[i] < 0.0f)
+      source.width = -frameWidth;
+
+    float drawX = prevX[i] + (posX[i] - prevX[i]) * alpha;
+    Vector2 size = frameSizes[(int)types[i]];
+    Rectangle dest = {drawX, posY[i], size.x, size.y};
+    queue.Submit(RenderLayer::PROJECTILES, posY[i], sheet.texture.Get(), source, dest, RAYWHITE);
+  }
+}
+
+ProjectileStats ProjectilePool::GetStats() const
+{
+  return {count, capacity, highWater, spawned, overflows};
+}
+
+void ProjectilePool::LogStats() const
+{
+  TraceLog(LOG_INFO, "ProjectilePool: %d/%d active, high water %d, %lld spawned, %lld dropped",
+           count, capacity, highWater, spawned, overflows);
+}
@@ -0,0 +1,104 @@
+#include "includes/RenderQueue.hpp"
+#include "includes/Profiler.hpp"
+#include <algorithm>
+
+// Sort key layout, most significant first:
+//   [63..56] layer  [55..40] y-depth  [39..24] texture id  [23..0] submit index
+// The submit index keeps the sort stable and finds the command again.
+namespace
+{
+  const int indexBits = 24;
+  const uint64_t indexMask = (1ull << indexBits) - 1;
+
+  uint64_t MakeKey(RenderLayer layer, float depth, unsigned int textureId, size_t index)
+  {
+    uint64_t quantizedDepth = (uint64_t)std::clamp(depth, 0.0f, 65535.0f);
+    return ((uint64_t)layer << 56) |
+           (quantizedDepth << 40) |
+           ((uint64_t)(textureId & 0xFFFF) << 24) |
+           (index & indexMask);
+  }
+}
+
+void RenderQueue::Begin()
+{
+  commands.clear();
+  keys.clear();
+}
+
+void RenderQueue::Submit(RenderLayer layer, float depth, Texture2D texture, Rectangle source, Rectangle dest, Color tint)
+{
+  if (texture.id == 0 || commands.size() > indexMask)
+    return;
+
+  keys.push_back(MakeKey(layer, depth, texture.id, commands.size()));
+  commands.push_back({texture, source, dest, tint});
+}
+
+void RenderQueue::SubmitRect(RenderLayer layer, float depth, Rectangle rect, Color color)
+{
+  if (commands.size() > indexMask)
+    return;
+
+  keys.push_back(MakeKey(layer, depth, 0, commands.size()));
+  commands.push_back({{0, 0, 0, 0, 0}, {0, 0, 0, 0}, rect, color});
+}
+
+// LSD radix sort over the key bytes above the index. Each pass is stable so
+// commands with equal layer, depth and texture keep their submit order.
+void RenderQueue::SortKeys()
+{
+  scratch.resize(keys.size());
+
+  for (int shift = indexBits; shift < 64; shift += 8)
+  {
+    size_t offsets[257] = {0};
+    for (uint64_t key : keys)
+      offsets[((key >> shift) & 0xFF) + 1]++;
+
+    // Every key has the same byte here, nothing to reorder
+    if (std::find(offsets + 1, offsets + 257, keys.size()) != offsets + 257)
+      continue;
+
+    for (int i = 1; i < 257; i++)
+      offsets[i] += offsets[i - 1];
+
+    for (uint64_t key : keys)
+      scratch[offsets[(key >> shift) & 0xFF]++] = key;
+
+    keys.swap(scratch);
+  }
+}
+
+void RenderQueue::Flush()
+{
+  PROFILE_ZONE("RenderQueue::Flush");
+  SortKeys();
+
+  drawCount = 0;
+  batchCount = 0;
+  unsigned int boundTexture = ~0u;
+
+  for (uint64_t key : keys)
+  {
+    const SpriteCommand &command = commands[key & indexMask];
+
+    // raylib starts a new batch whenever the texture changes; rectangles use
+    // its internal shapes texture which we count as id 0
+    if (command.texture.id != boundTexture)
+    {
+      boundTexture = command.texture.id;
+      batchCount++;
+    }
+
+    if (command.texture.id == 0)
+      DrawRectangleRec(command.dest, command.tint);
+    else
+      DrawTexturePro(command.texture, command.source, command.dest, {0, 0}, 0.0f, command.tint);
+
+    drawCount++;
+  }
+
+  commands.clear();
+  keys.clear();
+}
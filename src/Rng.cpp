@@ -0,0 +1,42 @@
+#include "includes/Rng.hpp"
+
+namespace
+{
+  uint64_t SplitMix64(uint64_t &x)
+  {
+    uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+  }
+}
+
+Rng::Rng(uint64_t seed)
+{
+  uint64_t a = SplitMix64(seed);
+  uint64_t b = SplitMix64(seed);
+  state[0] = (uint32_t)a;
+  state[1] = (uint32_t)(a >> 32);
+  state[2] = (uint32_t)b;
+  state[3] = (uint32_t)(b >> 32);
+
+  // All zero is the one state xoshiro never leaves
+  if ((state[0] | state[1] | state[2] | state[3]) == 0)
+    state[0] = 1;
+}
+
+Rng Rng::ForStream(uint64_t seed, uint64_t stream)
+{
+  uint64_t mixed = seed;
+  return Rng(SplitMix64(mixed) ^ (stream * 0xD1B54A32D192ED03ull));
+}
+
+// The batch works on a local copy so the compiler can keep the state in
+// registers; writes through values could alias it otherwise
+void Rng::FillRange(int *values, int count, int min, int max)
+{
+  Rng local = *this;
+  for (int i = 0; i < count; i++)
+    values[i] = local.Range(min, max);
+  *this = local;
+}
@@ -0,0 +1,156 @@
+#include "includes/SoundPool.hpp"
+#include <algorithm>
+
+SoundPool::SoundPool(int maxActiveVoices)
+    : maxActive(maxActiveVoices),
+      playCount(0),
+      stolen(0),
+      dropped(0)
+{
+}
+
+SoundPool::~SoundPool()
+{
+  Unload();
+}
+
+int SoundPool::Add(Sound source, int voiceCount, int priority, float volume)
+{
+  if (source.stream.buffer == nullptr)
+    return -1;
+
+  Effect effect = {(int)voices.size(), std::max(voiceCount, 1), priority};
+  for (int i = 0; i < effect.voiceCount; i++)
+  {
+    Sound sound = i == 0 ? source : LoadSoundAlias(source);
+    SetSoundVolume(sound, volume);
+    voices.push_back({sound, (int)effects.size(), 0});
+  }
+
+  effects.push_back(effect);
+  return (int)effects.size() - 1;
+}
+
+void SoundPool::Unload()
+{
+  // Aliases first, they play from the source's samples
+  for (const Effect &effect : effects)
+  {
+    for (int i = effect.voiceCount - 1; i >= 0; i--)
+    {
+      Sound &sound = voices[effect.firstVoice + i].sound;
+      StopSound(sound);
+      if (i == 0)
+        UnloadSound(sound);
+      else
+        UnloadSoundAlias(sound);
+    }
+  }
+
+  effects.clear();
+  voices.clear();
+}
+
+bool SoundPool::Play(int effect)
+{
+  if (effect < 0 || effect >= (int)effects.size())
+    return false;
+
+  const Effect &target = effects[effect];
+  int endVoice = target.firstVoice + target.voiceCount;
+
+  int voice = -1;
+  for (int i = target.firstVoice; i < endVoice && voice < 0; i++)
+  {
+    if (!IsSoundPlaying(voices[i].sound))
+      voice = i;
+  }
+
+  // Out of voices: make room inside the effect when all of its own are busy,
+  // anywhere in the pool when only the cap is in the way
+  if (voice < 0 || GetActiveCount() >= maxActive)
+  {
+    int victim = voice < 0 ? FindVictim(target.firstVoice, endVoice, target.priority)
+                           : FindVictim(0, (int)voices.size(), target.priority);
+    if (victim < 0)
+    {
+      dropped++;
+      return false;
+    }
+
+    StopSound(voices[victim].sound);
+    stolen++;
+    if (voice < 0)
+      voice = victim;
+  }
+
+  PlaySound(voices[voice].sound);
+  voices[voice].started = ++playCount;
+  return true;
+}
+
+int SoundPool::FindVictim(int firstVoice, int endVoice, int priority) const
+{
+  int victim = -1;
+  for (int i = firstVoice; i < endVoice; i++)
+  {
+    int voicePriority = effects[voices[i].effect].priority;
+    if (voicePriority > priority || !IsSoundPlaying(voices[i].sound))
+      continue;
+
+    if (victim < 0)
+    {
+      victim = i;
+      continue;
+    }
+
+    int victimPriority = effects[voices[victim].effect].priority;
+    if (voicePriority < victimPriority ||
+        (voicePriority == victimPriority && voices[i].started < voices[victim].started))
+      victim = i;
+  }
+  return victim;
+}
+
+bool SoundPool::IsPlaying(int effect) const
+{
+  if (effect < 0 || effect >= (int)effects.size())
+    return false;
+
+  const Effect &target = effects[effect];
+  for (int i = target.firstVoice; i < target.firstVoice + target.voiceCount; i++)
+  {
+    if (IsSoundPlaying(voices[i].sound))
+      return true;
+  }
+  return false;
+}
+
+void SoundPool::SetVolume(int effect, float volume)
+{
+  if (effect < 0 || effect >= (int)effects.size())
+    return;
+
+  const Effect &target = effects[effect];
+  for (int i = target.firstVoice; i < target.firstVoice + target.voiceCount; i++)
+    SetSoundVolume(voices[i].sound, volume);
+}
+
+int SoundPool::GetActiveCount() const
+{
+  int active = 0;
+  for (const Voice &voice : voices)
+    active += IsSoundPlaying(voice.sound) ? 1 : 0;
+  return active;
+}
+
+SoundPoolStats SoundPool::GetStats() const
+{
+  return {GetActiveCount(), maxActive, playCount, stolen, dropped};
+}
+
+void SoundPool::LogStats() const
+{
+  TraceLog(LOG_INFO, "SoundPool: %d effects, %d voices, %lld played, %lld stolen, %lld dropped",
+           (int)effects.size(), (int)voices.size(), playCount, stolen, dropped);
+}
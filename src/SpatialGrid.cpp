@@ -0,0 +1,159 @@
+#include "includes/SpatialGrid.hpp"
+#include <algorithm>
+
+SpatialGrid::SpatialGrid(float cellSize)
+    : cellSize(cellSize),
+      inverseCellSize(1.0f / cellSize),
+      origin({0.0f, 0.0f}),
+      columns(0),
+      rows(0),
+      itemCount(0),
+      cellMoves(0)
+{
+}
+
+void SpatialGrid::SetBounds(Rectangle area)
+{
+  Clear();
+  cells.clear();
+
+  origin = {area.x, area.y};
+  columns = std::max(1, (int)ceilf(area.width * inverseCellSize));
+  rows = std::max(1, (int)ceilf(area.height * inverseCellSize));
+  denseCells.assign((size_t)columns * rows, std::vector<int>());
+}
+
+const std::vector<int> *SpatialGrid::FindCell(int cx, int cy) const
+{
+  if (columns > 0)
+    return &denseCells[(size_t)cy * columns + cx];
+
+  auto cell = cells.find(CellKey(cx, cy));
+  return cell == cells.end() ? nullptr : &cell->second;
+}
+
+std::vector<int> &SpatialGrid::GetCell(int cx, int cy)
+{
+  if (columns > 0)
+    return denseCells[(size_t)cy * columns + cx];
+
+  return cells[CellKey(cx, cy)];
+}
+
+void SpatialGrid::Clear()
+{
+  for (auto &cell : cells)
+    cell.second.clear();
+  for (std::vector<int> &cell : denseCells)
+    cell.clear();
+
+  items.clear();
+  itemCount = 0;
+  cellMoves = 0;
+}
+
+SpatialGrid::CellRange SpatialGrid::RangeOf(Rectangle bounds) const
+{
+  if (columns > 0)
+  {
+    float left = bounds.x - origin.x;
+    float top = bounds.y - origin.y;
+    return {std::clamp(CellCoord(left), 0, columns - 1), std::clamp(CellCoord(top), 0, rows - 1),
+            std::clamp(CellCoord(left + bounds.width), 0, columns - 1), std::clamp(CellCoord(top + bounds.height), 0, rows - 1)};
+  }
+
+  return {CellCoord(bounds.x), CellCoord(bounds.y),
+          CellCoord(bounds.x + bounds.width), CellCoord(bounds.y + bounds.height)};
+}
+
+void SpatialGrid::AddToCells(int id, const CellRange &range)
+{
+  for (int cy = range.minY; cy <= range.maxY; cy++)
+    for (int cx = range.minX; cx <= range.maxX; cx++)
+      GetCell(cx, cy).push_back(id);
+}
+
+void SpatialGrid::RemoveFromCells(int id, const CellRange &range)
+{
+  for (int cy = range.minY; cy <= range.maxY; cy++)
+  {
+    for (int cx = range.minX; cx <= range.maxX; cx++)
+    {
+      std::vector<int> &cell = GetCell(cx, cy);
+      auto it = std::find(cell.begin(), cell.end(), id);
+      if (it != cell.end())
+      {
+        *it = cell.back();
+        cell.pop_back();
+      }
+    }
+  }
+}
+
+void SpatialGrid::Insert(int id, Rectangle bounds)
+{
+  if (id < 0)
+    return;
+
+  if (Contains(id))
+  {
+    Update(id, bounds);
+    return;
+  }
+
+  if (id >= (int)items.size())
+    items.resize(id + 1, {{0, 0, 0, 0}, {0, 0, -1, -1}, false});
+
+  Item &item = items[id];
+  item.bounds = bounds;
+  item.range = RangeOf(bounds);
+  item.inGrid = true;
+  AddToCells(id, item.range);
+  itemCount++;
+}
+
+void SpatialGrid::Update(int id, Rectangle bounds)
+{
+  if (!Contains(id))
+  {
+    Insert(id, bounds);
+    return;
+  }
+
+  Item &item = items[id];
+  item.bounds = bounds;
+
+  CellRange range = RangeOf(bounds);
+  if (range == item.range)
+    return;
+
+  RemoveFromCells(id, item.range);
+  AddToCells(id, range);
+  item.range = range;
+  cellMoves++;
+}
+
+void SpatialGrid::Remove(int id)
+{
+  if (!Contains(id))
+    return;
+
+  Item &item = items[id];
+  RemoveFromCells(id, item.range);
+  item.inGrid = false;
+  itemCount--;
+}
+
+void SpatialGrid::QueryRect(Rectangle area, std::vector<int> &result) const
+{
+  result.clear();
+  QueryRect(area, [&](int id, Rectangle)
+            { result.push_back(id); });
+}
+
+void SpatialGrid::QueryRadius(Vector2 center, float radius, std::vector<int> &result) const
+{
+  result.clear();
+  QueryRadius(center, radius, [&](int id, Rectangle)
+              { result.push_back(id); });
+}
@@ -0,0 +1,325 @@
+#include "includes/SpriteAtlas.hpp"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+namespace
+{
+  struct AtlasSprite
+  {
+    int page;
+    Rectangle rect;
+    std::vector<Rectangle> trims;
+  };
+
+  std::vector<std::string> pagePaths;
+  std::vector<TextureHandle> pages; // Acquired on first use
+  std::unordered_map<std::string, AtlasSprite> sprites;
+
+  const int atlasPadding = 2; // Transparent gap so neighbouring sheets never bleed
+
+  // Far above anything Pack writes, so a damaged file can't make Load
+  // allocate without bound
+  const int maxPages = 256;
+  const int maxFrames = 4096;
+}
+
+// SpriteRegion
+bool SpriteRegion::Trim(Rectangle &source, Rectangle &dest) const
+{
+  float cell = this->source.height;
+  int frame = (int)((source.x - this->source.x) / cell);
+  if (std::fabs(source.width) != cell || source.height != cell || frame < 0 || frame >= (int)trims.size())
+    return true;
+
+  const Rectangle &trim = trims[frame];
+  if (trim.width <= 0.0f || trim.height <= 0.0f)
+    return false;
+
+  // Mirrored frames have their border on the other side
+  bool mirrored = source.width < 0.0f;
+  float scaleX = dest.width / cell;
+  float scaleY = dest.height / cell;
+  float offsetX = mirrored ? cell - trim.x - trim.width : trim.x;
+
+  source = {source.x + trim.x, source.y + trim.y, mirrored ? -trim.width : trim.width, trim.height};
+  dest = {dest.x + offsetX * scaleX, dest.y + trim.y * scaleY, trim.width * scaleX, trim.height * scaleY};
+  return true;
+}
+
+Rectangle SpriteRegion::GetOpaqueBounds() const
+{
+  float cell = source.height;
+  float minX = cell, minY = cell, maxX = 0.0f, maxY = 0.0f;
+
+  for (const Rectangle &trim : trims)
+  {
+    if (trim.width <= 0.0f || trim.height <= 0.0f)
+      continue;
+
+    // Mirrored as well as it is
+    minX = std::min({minX, trim.x, cell - trim.x - trim.width});
+    maxX = std::max({maxX, trim.x + trim.width, cell - trim.x});
+    minY = std::min(minY, trim.y);
+    maxY = std::max(maxY, trim.y + trim.height);
+  }
+
+  if (cell <= 0.0f || maxX <= minX || maxY <= minY)
+    return {0.0f, 0.0f, 1.0f, 1.0f};
+
+  return {minX / cell, minY / cell, (maxX - minX) / cell, (maxY - minY) / cell};
+}
+
+// SpriteAtlas
+bool SpriteAtlas::Load(const std::string &metaPath)
+{
+  Unload();
+
+  std::ifstream file(metaPath);
+  if (!file)
+  {
+    TraceLog(LOG_INFO, "SpriteAtlas: %s not found, using standalone sheets", metaPath.c_str());
+    return false;
+  }
+
+  std::string directory = std::filesystem::path(metaPath).parent_path().generic_string();
+  std::string line;
+  int badLines = 0;
+
+  while (std::getline(file, line))
+  {
+    std::istringstream in(line);
+    std::string tag;
+    in >> tag;
+
+    if (tag == "page")
+    {
+      int index = -1;
+      std::string pageFile;
+      if (!(in >> index >> pageFile) || index < 0 || index >= maxPages)
+      {
+        badLines++;
+        continue;
+      }
+
+      if ((int)pagePaths.size() <= index)
+      {
+        pagePaths.resize(index + 1);
+        pages.resize(index + 1);
+      }
+      pagePaths[index] = directory + "/" + pageFile;
+    }
+    else if (tag == "sprite")
+    {
+      AtlasSprite sprite;
+      std::string path;
+      in >> sprite.page >> sprite.rect.x >> sprite.rect.y >> sprite.rect.width >> sprite.rect.height >> std::ws;
+      if (!in || !std::getline(in, path) || path.empty() || sprite.page < 0)
+      {
+        badLines++;
+        continue;
+      }
+      sprites[path] = sprite;
+    }
+    else if (tag == "trim")
+    {
+      int count = -1;
+      if (!(in >> count) || count < 0 || count > maxFrames)
+      {
+        badLines++;
+        continue;
+      }
+
+      std::vector<Rectangle> trims(count);
+      for (Rectangle &trim : trims)
+        in >> trim.x >> trim.y >> trim.width >> trim.height;
+
+      std::string path;
+      in >> std::ws;
+      auto it = in && std::getline(in, path) ? sprites.find(path) : sprites.end();
+      if (it != sprites.end())
+        it->second.trims = std::move(trims);
+      else
+        badLines++;
+    }
+  }
+
+  if (badLines > 0)
+    TraceLog(LOG_WARNING, "SpriteAtlas: skipped %d malformed lines in %s", badLines, metaPath.c_str());
+  TraceLog(LOG_INFO, "SpriteAtlas: %d sheets on %d pages", (int)sprites.size(), (int)pagePaths.size());
+  return !pagePaths.empty();
+}
+
+void SpriteAtlas::Unload()
+{
+  pagePaths.clear();
+  pages.clear();
+  sprites.clear();
+}
+
+SpriteRegion SpriteAtlas::Acquire(const std::string &path)
+{
+  auto it = sprites.find(path);
+  if (it != sprites.end() && it->second.page < (int)pages.size())
+  {
+    TextureHandle &page = pages[it->second.page];
+    if (!page.IsValid())
+      page = TextureCache::Acquire(pagePaths[it->second.page]);
+    if (page.IsValid())
+      return {page, it->second.rect, it->second.trims};
+  }
+
+  // Not packed: the sheet is its own texture
+  TextureHandle texture = TextureCache::Acquire(path);
+  Rectangle source = {0.0f, 0.0f, (float)texture.GetWidth(), (float)texture.GetHeight()};
+  return {texture, source, {}};
+}
+
+std::string SpriteAtlas::GetTexturePath(const std::string &path)
+{
+  auto it = sprites.find(path);
+  if (it != sprites.end() && it->second.page < (int)pagePaths.size())
+    return pagePaths[it->second.page];
+  return path;
+}
+
+bool SpriteAtlas::Pack(const std::vector<std::string> &sheetDirs, const std::string &outDir, int pageSize)
+{
+  struct PackedSheet
+  {
+    std::string path;
+    Image image;
+    int page;
+    int x, y;
+    std::vector<Rectangle> trims;
+  };
+
+  std::vector<PackedSheet> sheets;
+
+  for (const std::string &dir : sheetDirs)
+  {
+    std::vector<std::string> files;
+    for (const auto &entry : std::filesystem::directory_iterator(dir))
+    {
+      if (entry.is_regular_file() && entry.path().extension() == ".png")
+        files.push_back(entry.path().generic_string());
+    }
+    std::sort(files.begin(), files.end()); // Stable output between runs
+
+    for (const std::string &path : files)
+    {
+      Image image = LoadImage(path.c_str());
+      if (image.data == nullptr)
+        continue;
+
+      if (image.width + atlasPadding > pageSize || image.height + atlasPadding > pageSize)
+      {
+        TraceLog(LOG_WARNING, "SpriteAtlas: %s is larger than a page, left standalone", path.c_str());
+        UnloadImage(image);
+        continue;
+      }
+
+      ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+      sheets.push_back({path, image, 0, 0, 0, {}});
+
+      // Opaque part of every frame, for sheets that are a row of square frames
+      if (image.width % image.height == 0)
+      {
+        for (int x = 0; x < image.width; x += image.height)
+        {
+          Rectangle cell = {(float)x, 0.0f, (float)image.height, (float)image.height};
+          Image frame = ImageFromImage(image, cell);
+          sheets.back().trims.push_back(GetImageAlphaBorder(frame, 0.0f));
+          UnloadImage(frame);
+        }
+      }
+    }
+  }
+
+  if (sheets.empty())
+  {
+    TraceLog(LOG_WARNING, "SpriteAtlas: no sheets to pack");
+    return false;
+  }
+
+  // Shelf packing: tallest sheets first, each shelf as tall as its first sheet
+  std::sort(sheets.begin(), sheets.end(), [](const PackedSheet &a, const PackedSheet &b)
+            { return a.image.height != b.image.height ? a.image.height > b.image.height
+                                                      : a.image.width > b.image.width; });
+
+  int page = 0;
+  int shelfX = 0, shelfY = 0, shelfHeight = 0;
+
+  for (PackedSheet &sheet : sheets)
+  {
+    int w = sheet.image.width + atlasPadding;
+    int h = sheet.image.height + atlasPadding;
+
+    if (shelfX + w > pageSize)
+    {
+      shelfY += shelfHeight;
+      shelfX = 0;
+      shelfHeight = 0;
+    }
+    if (shelfY + h > pageSize)
+    {
+      page++;
+      shelfX = shelfY = shelfHeight = 0;
+    }
+
+    sheet.page = page;
+    sheet.x = shelfX;
+    sheet.y = shelfY;
+    shelfX += w;
+    shelfHeight = std::max(shelfHeight, h);
+  }
+
+  std::filesystem::create_directories(outDir);
+  std::ofstream meta(outDir + "/sprites.atlas");
+  meta << "# SpriteAtlas v2: page <index> <file> | sprite <page> <x> <y> <w> <h> <source path>"
+          " | trim <frames> (<x> <y> <w> <h>)... <source path>\n";
+
+  bool ok = true;
+  for (int p = 0; p <= page; p++)
+  {
+    Image pageImage = GenImageColor(pageSize, pageSize, BLANK);
+
+    for (const PackedSheet &sheet : sheets)
+    {
+      if (sheet.page != p)
+        continue;
+
+      Rectangle src = {0.0f, 0.0f, (float)sheet.image.width, (float)sheet.image.height};
+      Rectangle dst = {(float)sheet.x, (float)sheet.y, src.width, src.height};
+      ImageDraw(&pageImage, sheet.image, src, dst, WHITE);
+    }
+
+    std::string pageFile = "sprites_" + std::to_string(p) + ".png";
+    ok = ExportImage(pageImage, (outDir + "/" + pageFile).c_str()) && ok;
+    UnloadImage(pageImage);
+
+    meta << "page " << p << " " << pageFile << "\n";
+  }
+
+  for (const PackedSheet &sheet : sheets)
+  {
+    meta << "sprite " << sheet.page << " " << sheet.x << " " << sheet.y << " "
+         << sheet.image.width << " " << sheet.image.height << " " << sheet.path << "\n";
+    UnloadImage(sheet.image);
+
+    if (sheet.trims.empty())
+      continue;
+
+    meta << "trim " << sheet.trims.size();
+    for (const Rectangle &trim : sheet.trims)
+      meta << " " << trim.x << " " << trim.y << " " << trim.width << " " << trim.height;
+    meta << " " << sheet.path << "\n";
+  }
+
+  TraceLog(LOG_INFO, "SpriteAtlas: packed %d sheets into %d pages of %dx%d",
+           (int)sheets.size(), page + 1, pageSize, pageSize);
+  return ok;
+}
@@ -1,10 +1,140 @@
 #include "includes/TextOutlined.hpp"
+#include "includes/Profiler.hpp"
+#include <rlgl.h>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace
+{
+  const int cacheSize = 32;
+  const int outline = 1; // Pixels around the text
+
+  struct OutlinedText
+  {
+    uint64_t hash;
+    std::string text; // Copied once when the entry is rendered
+    int fontSize;
+    Color textColor, outlineColor;
+    RenderTexture2D target;
+    unsigned long long lastUsed;
+  };
+
+  OutlinedText cache[cacheSize] = {};
+  unsigned long long drawCount = 0;
+
+  uint64_t HashKey(const char *text, int fontSize, Color textColor, Color outlineColor)
+  {
+    uint64_t hash = 14695981039346656037ull; // FNV-1a
+    for (const char *c = text; *c != '\0'; c++)
+      hash = (hash ^ (uint8_t)*c) * 1099511628211ull;
+
+    uint32_t colors[2];
+    memcpy(&colors[0], &textColor, sizeof(uint32_t));
+    memcpy(&colors[1], &outlineColor, sizeof(uint32_t));
+    hash = (hash ^ (uint64_t)fontSize) * 1099511628211ull;
+    hash = (hash ^ colors[0]) * 1099511628211ull;
+    hash = (hash ^ colors[1]) * 1099511628211ull;
+    return hash;
+  }
+
+  bool SameColor(Color a, Color b)
+  {
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+  }
+
+  void Render(OutlinedText &entry, const char *text, int fontSize, Color textColor, Color outlineColor)
+  {
+    PROFILE_ZONE("DrawTextOutlined::Render");
+    int width = MeasureText(text, fontSize) + outline * 2;
+    int height = fontSize + outline * 2;
+
+    if (entry.target.id != 0 && (entry.target.texture.width != width || entry.target.texture.height != height))
+    {
+      UnloadRenderTexture(entry.target);
+      entry.target = {};
+    }
+    if (entry.target.id == 0)
+      entry.target = LoadRenderTexture(width, height);
+
+    entry.text = text;
+    entry.fontSize = fontSize;
+    entry.textColor = textColor;
+    entry.outlineColor = outlineColor;
+
+    // Same premultiplied compositing as LayerStrip, so the outline's edge
+    // keeps its coverage when the quad is blended over the scene
+    BeginTextureMode(entry.target);
+    ClearBackground(BLANK);
+    rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA, RL_FUNC_ADD, RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+
+    DrawText(text, 0, 0, fontSize, outlineColor);
+    DrawText(text, outline * 2, 0, fontSize, outlineColor);
+    DrawText(text, 0, outline * 2, fontSize, outlineColor);
+    DrawText(text, outline * 2, outline * 2, fontSize, outlineColor);
+    DrawText(text, outline, outline, fontSize, textColor);
+
+    EndBlendMode();
+    EndTextureMode();
+  }
+}
 
 void DrawTextOutlined(const char *text, int posX, int posY, int fontSize, Color textColor, Color outlineColor)
 {
-  DrawText(text, posX - 1, posY - 1, fontSize, outlineColor);
-  DrawText(text, posX + 1, posY - 1, fontSize, outlineColor);
-  DrawText(text, posX - 1, posY + 1, fontSize, outlineColor);
-  DrawText(text, posX + 1, posY + 1, fontSize, outlineColor);
-  DrawText(text, posX, posY, fontSize, textColor);
+  if (text == nullptr || text[0] == '\0')
+    return;
+
+  uint64_t hash = HashKey(text, fontSize, textColor, outlineColor);
+  OutlinedText *entry = nullptr;
+  OutlinedText *oldest = &cache[0];
+
+  for (OutlinedText &candidate : cache)
+  {
+    if (candidate.target.id != 0 && candidate.hash == hash && candidate.fontSize == fontSize &&
+        SameColor(candidate.textColor, textColor) && SameColor(candidate.outlineColor, outlineColor) &&
+        candidate.text == text)
+    {
+      entry = &candidate;
+      break;
+    }
+    if (candidate.lastUsed < oldest->lastUsed)
+      oldest = &candidate;
+  }
+
+  if (entry == nullptr)
+  {
+    entry = oldest;
+    entry->hash = hash;
+    Render(*entry, text, fontSize, textColor, outlineColor);
+  }
+  entry->lastUsed = ++drawCount;
+
+  // Render textures are stored upside down, hence the negative height
+  const Texture2D &texture = entry->target.texture;
+  Rectangle source = {0.0f, 0.0f, (float)texture.width, -(float)texture.height};
+  Vector2 position = {(float)(posX - outline), (float)(posY - outline)};
+
+  // The default font only has fully covered or empty pixels, with opaque
+  // colors premultiplied and straight alpha agree and the blend mode (and
+  // with it the current batch) can stay as it is
+  if (textColor.a == 255 && outlineColor.a == 255)
+  {
+    DrawTextureRec(texture, source, position, WHITE);
+    return;
+  }
+
+  BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+  DrawTextureRec(texture, source, position, WHITE);
+  EndBlendMode();
+}
+
+void ClearTextOutlinedCache()
+{
+  for (OutlinedText &entry : cache)
+  {
+    if (entry.target.id != 0)
+      UnloadRenderTexture(entry.target);
+    entry = {};
+  }
 }
@@ -0,0 +1,249 @@
+#include "includes/TextureCache.hpp"
+#include "includes/AssetArchive.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <unordered_map>
+
+namespace
+{
+  std::unordered_map<std::string, std::unique_ptr<TextureCacheEntry>> entries;
+  TextureCacheStats stats = {0, 0, 0, 0, 0};
+  const Texture2D emptyTexture = {0, 0, 0, 0, 0};
+  bool generateMipmaps = false;
+}
+
+// TextureHandle
+TextureHandle::TextureHandle() : entry(nullptr) {}
+
+TextureHandle::TextureHandle(TextureCacheEntry *cacheEntry) : entry(cacheEntry)
+{
+  TextureCache::Retain(entry);
+}
+
+TextureHandle::TextureHandle(const TextureHandle &other) : entry(other.entry)
+{
+  TextureCache::Retain(entry);
+}
+
+TextureHandle::TextureHandle(TextureHandle &&other) noexcept : entry(other.entry)
+{
+  other.entry = nullptr;
+}
+
+TextureHandle &TextureHandle::operator=(const TextureHandle &other)
+{
+  if (entry != other.entry)
+  {
+    TextureCache::Retain(other.entry);
+    TextureCache::Release(entry);
+    entry = other.entry;
+  }
+  return *this;
+}
+
+TextureHandle &TextureHandle::operator=(TextureHandle &&other) noexcept
+{
+  if (this != &other)
+  {
+    TextureCache::Release(entry);
+    entry = other.entry;
+    other.entry = nullptr;
+  }
+  return *this;
+}
+
+TextureHandle::~TextureHandle()
+{
+  TextureCache::Release(entry);
+}
+
+const Texture2D &TextureHandle::Get() const
+{
+  return entry != nullptr ? entry->texture : emptyTexture;
+}
+
+void TextureHandle::Reset()
+{
+  TextureCache::Release(entry);
+  entry = nullptr;
+}
+
+// TextureCache
+TextureHandle TextureCache::Acquire(const std::string &path, float scale)
+{
+  scale = GetLoadScale(scale);
+  std::string resolved = AssetArchive::Resolve(path);
+  std::string key = GetKey(resolved, scale);
+  auto it = entries.find(key);
+  if (it != entries.end())
+  {
+    stats.hits++;
+    return TextureHandle(it->second.get());
+  }
+
+  stats.misses++;
+
+  bool borrowed = false;
+  Image image = AssetArchive::GetImage(resolved, &borrowed);
+  if (scale == 1.0f)
+  {
+    if (image.data != nullptr)
+      return Insert(key, Upload(key, image, !borrowed, false), scale);
+
+    // Failed loads are cached too so a missing file is only reported once
+    return Insert(key, LoadTexture(path.c_str()), scale);
+  }
+
+  if (image.data == nullptr)
+    image = LoadImage(path.c_str());
+
+  Image resampled = {};
+  if (image.data != nullptr)
+    resampled = Resample(image, scale);
+  if (!borrowed)
+    UnloadImage(image);
+
+  return Insert(key, Upload(key, resampled, true, generateMipmaps), scale);
+}
+
+TextureHandle TextureCache::Adopt(const std::string &path, Image image, bool owned, float scale)
+{
+  scale = GetLoadScale(scale);
+  std::string key = GetKey(AssetArchive::Resolve(path), scale);
+  auto it = entries.find(key);
+  if (it != entries.end())
+  {
+    stats.hits++;
+    if (owned)
+      UnloadImage(image);
+    return TextureHandle(it->second.get());
+  }
+
+  stats.misses++;
+  return Insert(key, Upload(key, image, owned, scale != 1.0f && generateMipmaps), scale);
+}
+
+Image TextureCache::Resample(const Image &image, float scale)
+{
+  int width = std::max(1, (int)std::lround(image.width * scale));
+  int height = std::max(1, (int)std::lround(image.height * scale));
+
+  // Filtering straight alpha would average in the colour of fully
+  // transparent pixels, which shows as dark fringes along every edge
+  Image resampled = ImageCopy(image);
+  ImageFormat(&resampled, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+  ImageAlphaPremultiply(&resampled);
+  ImageResize(&resampled, width, height);
+
+  unsigned char *pixels = (unsigned char *)resampled.data;
+  for (int i = 0; i < width * height; i++)
+  {
+    unsigned char *pixel = pixels + i * 4;
+    int alpha = pixel[3];
+    if (alpha == 0 || alpha == 255)
+      continue;
+
+    for (int c = 0; c < 3; c++)
+      pixel[c] = (unsigned char)std::min(255, (pixel[c] * 255 + alpha / 2) / alpha);
+  }
+
+  return resampled;
+}
+
+void TextureCache::SetMipmaps(bool enabled)
+{
+  generateMipmaps = enabled;
+}
+
+std::string TextureCache::GetKey(const std::string &path, float scale)
+{
+  if (scale == 1.0f)
+    return path;
+
+  char suffix[32];
+  snprintf(suffix, sizeof(suffix), "@%gx", scale);
+  return path + suffix;
+}
+
+Texture2D TextureCache::Upload(const std::string &path, Image image, bool owned, bool mipmaps)
+{
+  if (image.data == nullptr)
+  {
+    TraceLog(LOG_WARNING, "TextureCache: no pixels for %s", path.c_str());
+    return {0, 0, 0, 0, 0};
+  }
+
+  Texture2D texture = LoadTextureFromImage(image);
+  if (owned)
+    UnloadImage(image);
+
+  if (mipmaps && texture.id != 0)
+  {
+    GenTextureMipmaps(&texture);
+    SetTextureFilter(texture, TEXTURE_FILTER_TRILINEAR);
+  }
+  return texture;
+}
+
+TextureHandle TextureCache::Insert(const std::string &key, Texture2D texture, float scale)
+{
+  std::unique_ptr<TextureCacheEntry> entry(new TextureCacheEntry{key, texture, 0, 0, scale});
+  if (entry->texture.id != 0)
+  {
+    // Each mip level is a quarter of the one above
+    for (int level = 0, w = texture.width, h = texture.height; level < texture.mipmaps; level++)
+    {
+      entry->bytes += GetPixelDataSize(w, h, texture.format);
+      w = std::max(1, w / 2);
+      h = std::max(1, h / 2);
+    }
+    stats.resident++;
+    stats.bytesResident += entry->bytes;
+    stats.bytesPeak = std::max(stats.bytesPeak, stats.bytesResident);
+  }
+
+  TextureCacheEntry *raw = entry.get();
+  entries.emplace(key, std::move(entry));
+  return TextureHandle(raw);
+}
+
+void TextureCache::Retain(TextureCacheEntry *entry)
+{
+  if (entry != nullptr)
+    entry->refCount++;
+}
+
+void TextureCache::Release(TextureCacheEntry *entry)
+{
+  if (entry == nullptr || --entry->refCount > 0)
+    return;
+
+  if (entry->texture.id != 0)
+  {
+    UnloadTexture(entry->texture);
+    stats.resident--;
+    stats.bytesResident -= entry->bytes;
+  }
+
+  // Copy the key, erasing destroys the entry that owns it
+  std::string path = entry->path;
+  entries.erase(path);
+}
+
+TextureCacheStats TextureCache::GetStats()
+{
+  return stats;
+}
+
+void TextureCache::ResetPeak()
+{
+  stats.bytesPeak = stats.bytesResident;
+}
+
+void TextureCache::LogStats()
+{
+  TraceLog(LOG_INFO, "TextureCache: %d hits, %d misses, %d resident (%.2f MB)",
+           stats.hits, stats.misses, stats.resident, stats.bytesResident / (1024.0f * 1024.0f));
+}
@@ -0,0 +1,129 @@
+#include "includes/World.hpp"
+#include "includes/Profiler.hpp"
+#include <algorithm>
+
+World::World()
+    : player(nullptr),
+      jobs(nullptr),
+      width(0.0f),
+      height(0.0f),
+      tick(0)
+{
+}
+
+World::~World()
+{
+  Unload();
+}
+
+void World::Init(float worldWidth, float worldHeight, int botCount, uint64_t seed)
+{
+  Unload();
+
+  rng = Rng(seed);
+  width = worldWidth;
+  height = worldHeight;
+  tick = 0;
+
+  // Resources are only paths here, the renderer loads them separately
+  player = new Character("resource/player/Idle.png",
+                         "resource/player/Idle_2.png",
+                         "resource/player/Walk.png",
+                         "resource/player/Run.png",
+                         "resource/player/Shot.png",
+                         "resource/player/Jump.png",
+                         "resource/player/Attack_1.png",
+                         "Audio/Gun.mp3",
+                         "Audio/Attack.mp3",
+                         120.0f, 270.0f, 120.0f);
+  player->SetJumpSpeed(900.0f);
+  player->SetGravity(2880.0f);
+  player->SetGroundY(270.0f);
+  player->SetFireCooldown(0.3f);
+  player->SetWorldSize({width, height});
+  player->SetProjectilePool(&projectiles);
+  projectiles.Clear();
+  flowField.SetBounds({0.0f, 0.0f, width, height});
+
+  // Only chasing bots use the field. Leave room for detours around obstacles
+  float chaseRange = 0.0f;
+  for (int type = 0; type < BotTypeCount; type++)
+    chaseRange = std::max(chaseRange, BotPool::GetArchetype((BotType)type).chaseRange);
+  flowField.SetRange(chaseRange * 2.0f);
+
+  SpawnBots(botCount);
+}
+
+void World::SpawnBots(int count)
+{
+  bots.Clear();
+  bots.Reserve(count);
+  bots.SetWorldSize({width, height});
+  bots.SetFlowField(&flowField);
+  // Drawn one at a time, the order operands of | are evaluated in is unspecified
+  uint64_t seedHigh = rng.Next();
+  uint64_t seedLow = rng.Next();
+  bots.SetSeed((seedHigh << 32) | seedLow);
+
+  std::vector<int> xs(count), ys(count), types(count);
+  rng.FillRange(xs.data(), count, 100, (int)width - 300);
+  rng.FillRange(ys.data(), count, 100, (int)height - 300);
+  rng.FillRange(types.data(), count, 0, BotTypeCount - 1);
+
+  for (int i = 0; i < count; ++i)
+    bots.Spawn(static_cast<BotType>(types[i]), (float)xs[i], (float)ys[i]);
+}
+
+void World::Step(float deltaTime, const InputState &input)
+{
+  PROFILE_ZONE("World::Step");
+  player->HandleInput(input);
+  player->Update(deltaTime);
+
+  Vector2 playerPos = {player->GetX(), player->GetY()};
+  bots.Integrate(deltaTime);
+  bots.Animate(deltaTime);
+  flowField.Update(playerPos, jobs); // No-op until obstacles are registered
+  bots.Think(playerPos, deltaTime, jobs);
+
+  projectiles.Update(deltaTime, width);
+  combat.Resolve(projectiles, bots);
+
+  tick++;
+}
+
+uint32_t World::GetChecksum() const
+{
+  // FNV-1a over the player and bot positions, states and health
+  uint32_t hash = 2166136261u;
+  auto mix = [&hash](const void *data, size_t size)
+  {
+    const unsigned char *bytes = (const unsigned char *)data;
+    for (size_t i = 0; i < size; i++)
+      hash = (hash ^ bytes[i]) * 16777619u;
+  };
+
+  float playerX = player->GetX(), playerY = player->GetY();
+  mix(&playerX, sizeof(playerX));
+  mix(&playerY, sizeof(playerY));
+
+  for (int i = 0; i < bots.GetCount(); i++)
+  {
+    Vector2 position = bots.GetPosition(i);
+    BotState state = bots.GetState(i);
+    int health = bots.GetHealth(i);
+    mix(&position, sizeof(position));
+    mix(&state, sizeof(state));
+    mix(&health, sizeof(health));
+  }
+
+  return hash;
+}
+
+void World::Unload()
+{
+  delete player;
+  player = nullptr;
+  bots.Clear();
+  projectiles.Clear();
+}
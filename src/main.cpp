@@ -1,23 +1,148 @@
 #include "includes/Controller.hpp"
+#include "includes/SpriteAtlas.hpp"
+#include "includes/AssetArchive.hpp"
+#include "includes/Headless.hpp"
+#include "includes/InputLog.hpp"
+#include "includes/Profiler.hpp"
 #include <raylib.h>
+#include <chrono>
 #include <iostream>
+#include <cstring>
+#include <cstdlib>
 
-int main()
+int main(int argc, char **argv)
 {
+    // Offline build step: pack the character sheets into atlas pages
+    if (argc > 1 && strcmp(argv[1], "--pack-atlas") == 0)
+    {
+        bool ok = SpriteAtlas::Pack({"resource/player",
+                                     "resource/thug",
+                                     "resource/gangster",
+                                     "resource/police",
+                                     "resource/civillian"},
+                                    "resource/atlas", 2048);
+        return ok ? 0 : 1;
+    }
+
+    // Offline build step: decode every image into one archive, after the
+    // atlas so its pages are included. --pack-assets raw skips compression
+    if (argc > 1 && strcmp(argv[1], "--pack-assets") == 0)
+    {
+        bool compress = !(argc > 2 && strcmp(argv[2], "raw") == 0);
+        return AssetArchive::Build({"resource"}, "resource/assets.pak", compress) ? 0 : 1;
+    }
+
+    // Simulation only, no window: --headless [ticks] [width] [height] [bots] [threads]
+    if (argc > 1 && strcmp(argv[1], "--headless") == 0)
+    {
+        HeadlessConfig config;
+        if (argc > 2)
+            config.ticks = atoll(argv[2]);
+        if (argc > 3)
+            config.worldWidth = (float)atof(argv[3]);
+        if (argc > 4)
+            config.worldHeight = (float)atof(argv[4]);
+        if (argc > 5)
+            config.botCount = atoi(argv[5]);
+        if (argc > 6)
+            config.threads = atoi(argv[6]);
+        return RunHeadless(config);
+    }
+
+    // Recorded session without a window: --replay <log> [threads] [timings.csv]
+    InputLog replayLog;
+    if (argc > 2 && strcmp(argv[1], "--replay") == 0)
+    {
+        if (!replayLog.Load(argv[2]))
+            return 1;
+
+        HeadlessConfig config;
+        config.replay = &replayLog;
+        if (argc > 3)
+            config.threads = atoi(argv[3]);
+        if (argc > 4)
+            config.timingsPath = argv[4];
+        return RunHeadless(config);
+    }
+
+    // Recorded session rendered as fast as it goes: --replay-window <log> [timings.csv]
+    bool replayWindow = argc > 2 && strcmp(argv[1], "--replay-window") == 0;
+    if (replayWindow && !replayLog.Load(argv[2]))
+        return 1;
+
+    // Normal session that saves its input: --record <log>
+    const char *recordPath = argc > 2 && strcmp(argv[1], "--record") == 0 ? argv[2] : nullptr;
+
     const int screenWidth = 960;
     const int screenHeight = 540;
     const int originalWidth = 1920;
     const int originalHeight = 1080;
+    // Render at the display refresh rate, the simulation runs on its own
+    // fixed step below so speed doesn't depend on the frame rate
+    if (!replayWindow)
+        SetConfigFlags(FLAG_VSYNC_HINT);
     InitWindow(screenWidth, screenHeight, "Mafia City");
-    SetTargetFPS(60);
+
+    // Drivers are free to ignore the vsync hint, capping at the refresh rate
+    // keeps the loop from spinning a whole core then
+    if (!replayWindow)
+    {
+        int refreshRate = GetMonitorRefreshRate(GetCurrentMonitor());
+        SetTargetFPS(refreshRate > 0 ? refreshRate : 60);
+    }
     Controller game;
 
+    if (recordPath != nullptr)
+        game.SetRecording(recordPath);
+    if (replayWindow)
+        game.SetReplay(&replayLog);
     game.Init(screenWidth, screenHeight, originalWidth, originalHeight);
 
+    // One tick per frame with no frame cap, timing every tick
+    if (replayWindow)
+    {
+        TickTimings timings;
+        timings.Reserve(replayLog.GetTickCount());
+        for (long long tick = 0; !game.IsReplayFinished() && !WindowShouldClose(); tick++)
+        {
+            auto start = std::chrono::steady_clock::now();
+            game.Update(Controller::FixedStep);
+            timings.Add(tick, std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+            game.Draw(1.0f);
+            Profiler::EndFrame();
+        }
+        timings.Print("replay");
+        if (argc > 3)
+            timings.Save(argv[3]);
+
+        game.Unload();
+        CloseAudioDevice();
+        CloseWindow();
+        return 0;
+    }
+
+    // Longest frame we try to catch up on, anything beyond is dropped so a
+    // long hitch can't snowball into ever more simulation steps
+    const float maxFrameTime = 0.25f;
+    double previousTime = GetTime();
+    float accumulator = 0.0f;
+
     while (!WindowShouldClose())
     {
-        game.Update();
-        game.Draw();
+        double now = GetTime();
+        float frameTime = (float)(now - previousTime);
+        previousTime = now;
+        accumulator += (frameTime < maxFrameTime) ? frameTime : maxFrameTime;
+
+        game.PollInput();
+        while (accumulator >= Controller::FixedStep)
+        {
+            game.Update(Controller::FixedStep);
+            accumulator -= Controller::FixedStep;
+        }
+
+        game.Draw(accumulator / Controller::FixedStep);
+        Profiler::EndFrame();
     }
     game.Unload();
 